@@ -72,6 +72,32 @@ REQUIRED_TRANSLATION_KEYS = [
     "above_horizon","below_horizon","not_home","start_cleaning","return_to_base","docked",
     "turn_on","turn_off"
 ]
+DATETIME_TRANSLATION = "datetime"
+## Labels with constant keys which are resolved at build time into the STATIC_TRANSLATIONS array,
+## paired with the entity types that use them (None = always used).
+## NOTE: The order of this list must match the 'static_translation' enum in translations.h,
+##       this is checked by a static_assert for each key in the generated code.
+STATIC_TRANSLATION_KEYS = [
+    ("currently", ['climate']), ("state", ['climate']),
+    ("press", ['button','input_button','navigate']), ("activate", ['scene']), ("run", ['script','service']),
+    ("speed", ['fan']), ("lock", ['lock']), ("unlock", ['lock']),
+    ("start_cleaning", ['vacuum']), ("return_to_base", ['vacuum']),
+    ("brightness", ['light']), ("color", ['light']), ("color_temp", ['light']),
+    ("position", ['cover']), ("tilt_position", ['cover']),
+    ("start", ['timer']), ("pause", ['timer']), ("cancel", ['timer']), ("finish", ['timer']),
+    ("disarm", ['alarm_control_panel']), ("arm_home", ['alarm_control_panel']),
+    ("arm_away", ['alarm_control_panel']), ("arm_night", ['alarm_control_panel']),
+    ("arm_vacation", ['alarm_control_panel']), ("arm_custom_bypass", ['alarm_control_panel']),
+    # the short day names are also used by the weather forecast
+    *[(k, [DATETIME_TRANSLATION] if i % 2 == 0 else None) for i, k in enumerate([
+        "dow_sunday","dow_sun","dow_monday","dow_mon","dow_tuesday","dow_tue","dow_wednesday","dow_wed",
+        "dow_thursday","dow_thu","dow_friday","dow_fri","dow_saturday","dow_sat"])],
+    *[(k, [DATETIME_TRANSLATION]) for k in [
+        "month_january","month_jan","month_february","month_feb","month_march","month_mar",
+        "month_april","month_apr","month_may","month_june","month_jun","month_july","month_jul",
+        "month_august","month_aug","month_september","month_sep","month_october","month_oct",
+        "month_november","month_nov","month_december","month_dec"]]
+]
 
 CONF_INCOMING_MSG = "on_incoming_msg"
 CONF_ICON = "icon"
@@ -100,6 +126,22 @@ CONF_CARD_TITLE = "title"
 CONF_CARD_SLEEP_TIMEOUT = "sleep_timeout"
 CONF_CARD_ENTITIES = "entities"
 CONF_CARD_ENTITIES_NAME = "name"
+CONF_STATE_FILTER = "state_filter"
+CONF_STATE_FILTER_PRECISION = "precision"
+CONF_STATE_FILTER_DEADBAND = "deadband"
+CONF_STATE_FILTER_DEADBAND_PERCENT = "deadband_percent"
+CONF_STATE_FILTER_MIN_INTERVAL = "min_interval"
+CONF_INPUT_INTERVAL = "input_interval"
+CONF_INPUT_INTERVAL_DEFAULT = "default"
+# input_interval config key -> TFT button type
+INPUT_INTERVAL_BUTTON_TYPES = {
+    "brightness": "brightnessSlider",
+    "color_temp": "colorTempSlider",
+    "volume": "volumeSlider",
+    "position": "positionSlider",
+    "tilt": "tiltSlider",
+    "color_wheel": "colorWheel",
+}
 
 CARD_ENTITIES="cardEntities"
 CARD_GRID="cardGrid"
@@ -158,6 +200,29 @@ def load_translations(lang: str):
         raise cv.Invalid(f"Translation file missing the following required keys: {missingKeys}")
     _LOGGER.info(f"[nspanel_lovelace] Loaded '{lang}' translation file")
 
+def get_static_translations(language: str) -> list[str]:
+    # Only include the labels which can be used by the configured entities,
+    # missing labels fall back to the english translation
+    used_types = set(id.split('.', 1)[0] for id in entity_ids.keys())
+    # note: date translation is skipped for english, see DateTimeFormat
+    if language not in ['en', 'en-GB']:
+        used_types.add(DATETIME_TRANSLATION)
+    defaultJson = None
+    values = []
+    for key, types in STATIC_TRANSLATION_KEYS:
+        if types is not None and used_types.isdisjoint(types):
+            values.append("")
+            continue
+        value = translationJson.get(key, None)
+        if value is None:
+            if defaultJson is None:
+                jsonPath = os.path.join(os.path.dirname(__file__), "translations", "en.json")
+                with open(jsonPath, encoding="utf-8") as read_file:
+                    defaultJson = json.load(read_file)
+            value = defaultJson.get(key, key)
+        values.append(value)
+    return values
+
 def get_icon_hex(iconLookup: str) -> Union[str, None]:
     if not iconLookup or len(iconLookup) == 0:
         return None
@@ -286,10 +351,29 @@ SCHEMA_SCREENSAVER = cv.Schema({
     cv.Optional(CONF_SCREENSAVER_STATUS_ICON_RIGHT): SCHEMA_STATUS_ICON,
 })
 
+# Reduces re-rendering for noisy numeric states, see EntityStateFilter
+SCHEMA_STATE_FILTER = cv.Schema({
+    cv.Optional(CONF_STATE_FILTER_PRECISION, default=-1): cv.int_range(-1, 6),
+    cv.Optional(CONF_STATE_FILTER_DEADBAND, default=0): cv.positive_float,
+    cv.Optional(CONF_STATE_FILTER_DEADBAND_PERCENT, default=0): cv.percentage,
+    cv.Optional(CONF_STATE_FILTER_MIN_INTERVAL, default="0s"): cv.positive_time_period_milliseconds,
+})
+
+valid_input_interval = cv.All(
+    cv.positive_time_period_milliseconds,
+    cv.Range(max=core.TimePeriod(milliseconds=10000)))
+
+# Repeated input events (e.g. slider drags) are coalesced per control, see InputCoalescer
+SCHEMA_INPUT_INTERVAL = cv.Schema({
+    cv.Optional(CONF_INPUT_INTERVAL_DEFAULT, default="200ms"): valid_input_interval,
+    **{cv.Optional(key): valid_input_interval for key in INPUT_INTERVAL_BUTTON_TYPES},
+})
+
 SCHEMA_CARD_ENTITY = cv.Schema({
     cv.Required(CONF_ENTITY_ID): valid_entity_id(),
     cv.Optional(CONF_CARD_ENTITIES_NAME): cv.string,
     cv.Optional(CONF_ICON): SCHEMA_ICON,
+    cv.Optional(CONF_STATE_FILTER): SCHEMA_STATE_FILTER,
 })
 
 SCHEMA_CARD_BASE = cv.Schema({
@@ -380,6 +464,7 @@ CONFIG_SCHEMA = cv.All(
         cv.Optional(CONF_MODEL, default='eu'): cv.one_of('eu', 'us-l', 'us-p'),
         cv.Optional(CONF_LOCALE, default={}): SCHEMA_LOCALE,
         cv.Optional(CONF_SCREENSAVER, default={}): SCHEMA_SCREENSAVER,
+        cv.Optional(CONF_INPUT_INTERVAL, default={}): SCHEMA_INPUT_INTERVAL,
         cv.Optional(CONF_INCOMING_MSG): automation.validate_automation(
             cv.Schema({
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(NSPanelLovelaceMsgIncomingTrigger),
@@ -523,6 +608,15 @@ def gen_card_entities(entities_config, card_class: cg.MockObjClass, card_variabl
 
         generate_icon_config(entity_config.get(CONF_ICON, None), entity_class)
 
+        state_filter = entity_config.get(CONF_STATE_FILTER, None)
+        if state_filter is not None:
+            # note: the filter is applied to the entity so it affects all cards which use it
+            cg.add(cg.MockObj(entity_id, "->").set_state_filter(
+                state_filter[CONF_STATE_FILTER_PRECISION],
+                state_filter[CONF_STATE_FILTER_DEADBAND],
+                state_filter[CONF_STATE_FILTER_DEADBAND_PERCENT],
+                state_filter[CONF_STATE_FILTER_MIN_INTERVAL].total_milliseconds))
+
         cg.add(card_variable.add_item(entity_class))
 
 def get_status_icon_statement(icon_config, icon_class: cg.MockObjClass, default_icon_value: str = 'alert-circle-outline'):
@@ -598,6 +692,14 @@ async def to_code(config):
     if CONF_SLEEP_TIMEOUT in config:
         cg.add(nspanel.set_display_timeout(config[CONF_SLEEP_TIMEOUT]))
 
+    input_interval = config[CONF_INPUT_INTERVAL]
+    cg.add(nspanel.set_input_interval(
+        input_interval[CONF_INPUT_INTERVAL_DEFAULT].total_milliseconds))
+    for key, button_type in INPUT_INTERVAL_BUTTON_TYPES.items():
+        if key in input_interval:
+            cg.add(nspanel.set_input_interval(
+                button_type, input_interval[key].total_milliseconds))
+
     locale_config = config[CONF_LOCALE]
     global translationJson
     load_translations(locale_config[CONF_LANGUAGE])
@@ -608,17 +710,39 @@ async def to_code(config):
     else:
         cg.add(nspanel.set_language(locale_config[CONF_LANGUAGE]))
 
+    static_translations = get_static_translations(locale_config[CONF_LANGUAGE])
+    cg.add_define("STATIC_TRANSLATION_COUNT", len(static_translations))
+    cg.add_global(cg.RawStatement(
+        "constexpr std::array<const char *, STATIC_TRANSLATION_COUNT> "
+        f"esphome::{nspanel_lovelace_ns}::STATIC_TRANSLATIONS = "
+        f"{{{cg.ArrayInitializer(*static_translations, multiline=True)}}};"))
+    # each key must be at the index of its static_translation enum value (see translations.h)
+    cg.add_global(cg.RawStatement("\n".join(
+        f"static_assert(static_cast<uint8_t>(esphome::{nspanel_lovelace_ns}::static_translation::{key}) == {index}, "
+        f"\"STATIC_TRANSLATION_KEYS in __init__.py does not match static_translation::{key}\");"
+        for index, (key, _) in enumerate(STATIC_TRANSLATION_KEYS))))
+
+    # note: only keys which are looked up at runtime (e.g. entity states) are added to the map
+    static_keys = [k for k, _ in STATIC_TRANSLATION_KEYS]
     cgv = []
     for k,v in translationJson.items():
+        if k in static_keys:
+            continue
         if k in REQUIRED_TRANSLATION_KEYS:
             if k in cv.RESERVED_IDS:
                 k += '_'
             k = TRANSLATION_ITEM.class_(k)
         cgv.append(cg.ArrayInitializer(k, v))
     cg.add_define("TRANSLATION_MAP_SIZE", len(cgv))
+    # note: make_frozen_map sorts the keys at compile time so binary search can be used
     cg.add_global(cg.RawStatement(
         "constexpr FrozenCharMap<const char *, TRANSLATION_MAP_SIZE> "
-        f"esphome::{nspanel_lovelace_ns}::TRANSLATION_MAP {{{cg.ArrayInitializer(*cgv, multiline=True)}}};"))
+        f"esphome::{nspanel_lovelace_ns}::TRANSLATION_MAP = "
+        "make_frozen_map<const char *, TRANSLATION_MAP_SIZE>("
+        f"{{{cg.ArrayInitializer(*cgv, multiline=True)}}});"))
+    cg.add_global(cg.RawStatement(
+        f"static_assert(esphome::{nspanel_lovelace_ns}::is_frozen_map_sorted("
+        f"esphome::{nspanel_lovelace_ns}::TRANSLATION_MAP), \"TRANSLATION_MAP must be sorted\");"))
 
     if CONF_TEMPERATURE_UNIT in locale_config:
         cg.add(GlobalConfig.set_temperature_unit(TEMPERATURE_UNIT_OPTION_MAP[locale_config[CONF_TEMPERATURE_UNIT]]))
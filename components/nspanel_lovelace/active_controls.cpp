@@ -0,0 +1,47 @@
+#include "active_controls.h"
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+void ActiveControls::on_input(const std::string &uuid, const std::string &button_type,
+    const std::string &value, uint32_t now) {
+  Control *target = nullptr;
+  for (auto &control : this->controls_) {
+    if (control.used && control.uuid == uuid && control.button_type == button_type) {
+      target = &control;
+      break;
+    }
+    if (target == nullptr || !control.used ||
+        (target->used && now - control.last_input > now - target->last_input)) {
+      target = &control;
+    }
+  }
+  if (target->uuid != uuid || target->button_type != button_type) {
+    target->uuid = uuid;
+    target->button_type = button_type;
+  }
+  target->value = value;
+  target->last_input = now;
+  target->used = true;
+}
+
+const std::string *ActiveControls::get_value(const std::string &uuid,
+    const char *button_type, uint32_t now) const {
+  for (auto &control : this->controls_) {
+    if (this->in_window_(control, now) &&
+        control.uuid == uuid && control.button_type == button_type) {
+      return &control.value;
+    }
+  }
+  return nullptr;
+}
+
+bool ActiveControls::is_active(const std::string &uuid, uint32_t now) const {
+  for (auto &control : this->controls_) {
+    if (this->in_window_(control, now) && control.uuid == uuid) return true;
+  }
+  return false;
+}
+
+} // namespace nspanel_lovelace
+} // namespace esphome
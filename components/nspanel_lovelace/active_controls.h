@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <stdint.h>
+#include <string>
+
+#include "config.h"
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+// Remembers the controls (item uuid + button type) the user recently changed.
+// HA sends the intermediate states back while a slider is being dragged, the
+// popup fields a control owns show the input value during the window instead
+// so the slider doesn't jump back under the user's finger.
+class ActiveControls {
+public:
+  // The number of controls remembered, the least recently used one is replaced
+  static constexpr uint8_t MAX_CONTROLS = 4;
+
+  void set_window(uint16_t window_ms) { this->window_ = window_ms; }
+
+  void on_input(const std::string &uuid, const std::string &button_type,
+      const std::string &value, uint32_t now);
+  // The latest input value if the control was used within the window, otherwise nullptr
+  const std::string *get_value(const std::string &uuid,
+      const char *button_type, uint32_t now) const;
+  // Any of the item's controls were used within the window
+  bool is_active(const std::string &uuid, uint32_t now) const;
+
+  void on_render_suppressed() { this->renders_suppressed_++; }
+  uint32_t get_renders_suppressed() const { return this->renders_suppressed_; }
+
+protected:
+  struct Control {
+    std::string uuid;
+    std::string button_type;
+    std::string value;
+    uint32_t last_input = 0;
+    bool used = false;
+  };
+  std::array<Control, MAX_CONTROLS> controls_;
+  uint16_t window_ = ACTIVE_CONTROL_WINDOW;
+  uint32_t renders_suppressed_ = 0;
+
+  bool in_window_(const Control &control, uint32_t now) const {
+    return control.used && now - control.last_input < this->window_;
+  }
+};
+
+} // namespace nspanel_lovelace
+} // namespace esphome
@@ -103,6 +103,29 @@ void EntitiesCardEntityItem::on_entity_attribute_change(
   this->set_render_invalid();
 }
 
+entity_notify_mask_t EntitiesCardEntityItem::get_entity_notify_mask_(const char *type) const {
+  auto mask = StatefulPageItem::get_entity_notify_mask_(type) |
+    entity_notify_attr(ha_attr_type::unit_of_measurement);
+  // The attributes which also require the state to be updated,
+  // this must match on_entity_attribute_change
+  if (type == entity_type::cover) {
+    mask |= entity_notify_attr(ha_attr_type::current_position);
+  } else if (type == entity_type::climate) {
+    mask |= entity_notify_attr(
+      ha_attr_type::temperature, ha_attr_type::current_temperature);
+  } else if (
+      type == entity_type::number ||
+      type == entity_type::input_number) {
+    mask |= entity_notify_attr(ha_attr_type::min, ha_attr_type::max);
+  } else if (type == entity_type::weather) {
+    mask |= entity_notify_attr(
+      ha_attr_type::temperature, ha_attr_type::temperature_unit);
+  } else if (type == entity_type::media_player) {
+    mask |= entity_notify::all_attributes;
+  }
+  return mask;
+}
+
 void EntitiesCardEntityItem::state_generic_fn(StatefulPageItem *me) {
   auto me_ = static_cast<EntitiesCardEntityItem*>(me);
   me_->value_ = get_translation(me_->get_state());
@@ -117,17 +140,17 @@ void EntitiesCardEntityItem::state_on_off_fn(StatefulPageItem *me) {
 void EntitiesCardEntityItem::state_button_fn(StatefulPageItem *me) {
   auto me_ = static_cast<EntitiesCardEntityItem*>(me);
   // frontend.ui.card.button.press
-  me_->value_ = get_translation(translation_item::press);
+  me_->value_ = get_translation(static_translation::press);
 }
 
 void EntitiesCardEntityItem::state_scene_fn(StatefulPageItem *me) {
   auto me_ = static_cast<EntitiesCardEntityItem*>(me);
-  me_->value_ = get_translation(translation_item::activate);
+  me_->value_ = get_translation(static_translation::activate);
 }
 
 void EntitiesCardEntityItem::state_script_fn(StatefulPageItem *me) {
   auto me_ = static_cast<EntitiesCardEntityItem*>(me);
-  me_->value_ = get_translation(translation_item::run);
+  me_->value_ = get_translation(static_translation::run);
 }
 
 void EntitiesCardEntityItem::state_timer_fn(StatefulPageItem *me) {
@@ -141,11 +164,8 @@ void EntitiesCardEntityItem::state_cover_fn(StatefulPageItem *me) {
   StatefulPageItem::state_cover_fn(me);
   auto me_ = static_cast<EntitiesCardEntityItem*>(me);
 
-  std::array<const char *, 4> cover_icons{};
-  bool cover_icons_found = try_get_value(COVER_MAP,
-    cover_icons,
-    me_->get_attribute(ha_attr_type::device_class),
-    entity_cover_type::window);
+  auto cover_icons = me_->get_cover_icons();
+  bool cover_icons_found = cover_icons != nullptr;
   auto &position_str = me_->get_attribute(
     ha_attr_type::current_position);
   auto &supported_features_str = me_->get_attribute(
@@ -159,12 +179,8 @@ void EntitiesCardEntityItem::state_cover_fn(StatefulPageItem *me) {
 
   me_->value_.clear();
 
-  if (!position_str.empty()) {
-    position = std::stoi(position_str);
-  }
-  if (!supported_features_str.empty()) {
-    supported_features = std::stoi(supported_features_str);
-  }
+  position = value_or_default(position_str, 0);
+  supported_features = value_or_default(supported_features_str, 0);
 
   // see: https://github.com/home-assistant/core/blob/dev/homeassistant/components/cover/__init__.py#L112
   // OPEN
@@ -175,7 +191,7 @@ void EntitiesCardEntityItem::state_cover_fn(StatefulPageItem *me) {
       icon_up_status = true;
     }
     if (cover_icons_found)
-      me_->value_.append(cover_icons.at(2));
+      me_->value_.append(cover_icons->at(2));
   }
   me_->value_.append(1, '|');
   // STOP
@@ -192,7 +208,7 @@ void EntitiesCardEntityItem::state_cover_fn(StatefulPageItem *me) {
       icon_down_status = true;
     }
     if (cover_icons_found)
-      me_->value_.append(cover_icons.at(3));
+      me_->value_.append(cover_icons->at(3));
   }
   me_->value_
     .append(1, '|')
@@ -217,7 +233,7 @@ void EntitiesCardEntityItem::state_climate_fn(StatefulPageItem *me) {
     me_->value_.append(1, ' ').append(temp).append(temp_unit);
   }
   me_->value_.append("\r\n")
-    .append(get_translation(translation_item::currently)).append(": ")
+    .append(get_translation(static_translation::currently)).append(": ")
     .append(me_->get_attribute(ha_attr_type::current_temperature))
     .append(temp_unit);
 }
@@ -237,7 +253,7 @@ void EntitiesCardEntityItem::state_lock_fn(StatefulPageItem *me) {
   StatefulPageItem::state_lock_fn(me);
   auto me_ = static_cast<EntitiesCardEntityItem*>(me);
   me_->value_ = get_translation(me_->is_state(entity_state::unlocked) ?
-    translation_item::lock : translation_item::unlock);
+    static_translation::lock : static_translation::unlock);
 }
 
 void EntitiesCardEntityItem::state_weather_fn(StatefulPageItem *me) {
@@ -262,23 +278,19 @@ void EntitiesCardEntityItem::state_sun_fn(StatefulPageItem *me) {
 void EntitiesCardEntityItem::state_vacuum_fn(StatefulPageItem *me) {
   auto me_ = static_cast<EntitiesCardEntityItem*>(me);
   me_->value_ = get_translation(me_->is_state(entity_state::docked) ?
-    translation_item::start_cleaning : translation_item::return_to_base);
+    static_translation::start_cleaning : static_translation::return_to_base);
 }
 
 void EntitiesCardEntityItem::state_translate_fn(StatefulPageItem *me) {
   auto me_ = static_cast<EntitiesCardEntityItem*>(me);
   // Firstly try to find a match for a specific entity type, then
   // find a match for the generic state, otherwise use the raw state value
-  const char *ret;
-  std::string key = me->get_type();
-  key.append(1, '.').append(me_->get_state());
-  if (!try_get_value(TRANSLATION_MAP, ret, key)) {
-    if (!try_get_value(TRANSLATION_MAP, ret, me_->get_state())) {
-      me_->value_ = me_->get_state();
-      return;
-    }
+  auto &state = me_->get_state();
+  auto ret = find_value(me_->presentation_.state_translations, state.c_str());
+  if (ret == nullptr) {
+    ret = find_value(TRANSLATION_MAP, state.c_str());
   }
-  me_->value_ = ret;
+  me_->value_ = ret == nullptr ? state : *ret;
 }
 
 void EntitiesCardEntityItem::set_on_state_callback_(const char *type) {
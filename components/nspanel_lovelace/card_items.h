@@ -46,6 +46,8 @@ public:
   const std::string &get_value() const { return this->value_; }
 
 protected:
+  entity_notify_mask_t get_entity_notify_mask_(const char *type) const override;
+
   static void state_generic_fn(StatefulPageItem *me);
   static void state_on_off_fn(StatefulPageItem *me);
   static void state_button_fn(StatefulPageItem *me);
@@ -57,14 +57,15 @@ AlarmCard::AlarmCard(
     Card(page_type::cardAlarm, uuid),
     alarm_entity_(alarm_entity),
     show_keypad_(true), status_icon_flashing_(false) {
-  alarm_entity_->add_subscriber(this);
+  alarm_entity_->add_subscriber(this,
+    entity_notify::state | entity_notify_attr(ha_attr_type::code_arm_required));
   this->status_icon_ = std::unique_ptr<AlarmIconItem>(
     new AlarmIconItem(std::string(uuid).append("_s"), icon_t::shield_off, 0x0CE6)); //green
   this->info_icon_ = std::unique_ptr<AlarmIconItem>(
     new AlarmIconItem(std::string(uuid).append("_i"), icon_t::progress_alert, 0xED80)); //orange
   this->disarm_button_ = std::unique_ptr<AlarmButtonItem>(
     new AlarmButtonItem(std::string(uuid).append("_d"),
-      button_type::disarm, get_translation(translation_item::disarm)));
+      button_type::disarm, get_translation(static_translation::disarm)));
 }
 AlarmCard::AlarmCard(
   const std::string &uuid, const std::shared_ptr<Entity> &alarm_entity,
@@ -72,14 +73,15 @@ AlarmCard::AlarmCard(
     Card(page_type::cardAlarm, uuid, title),
     alarm_entity_(alarm_entity),
     show_keypad_(true),status_icon_flashing_(false) {
-  alarm_entity_->add_subscriber(this);
+  alarm_entity_->add_subscriber(this,
+    entity_notify::state | entity_notify_attr(ha_attr_type::code_arm_required));
   this->status_icon_ = std::unique_ptr<AlarmIconItem>(
     new AlarmIconItem(std::string(uuid).append("_s"), icon_t::shield_off, 0x0CE6)); //green
   this->info_icon_ = std::unique_ptr<AlarmIconItem>(
     new AlarmIconItem(std::string(uuid).append("_i"), icon_t::progress_alert, 0xED80)); //orange
   this->disarm_button_ = std::unique_ptr<AlarmButtonItem>(
     new AlarmButtonItem(std::string(uuid).append("_d"),
-      button_type::disarm, get_translation(translation_item::disarm)));
+      button_type::disarm, get_translation(static_translation::disarm)));
 }
 AlarmCard::AlarmCard(
     const std::string &uuid, const std::shared_ptr<Entity> &alarm_entity,
@@ -87,14 +89,15 @@ AlarmCard::AlarmCard(
     Card(page_type::cardAlarm, uuid, title, sleep_timeout),
     alarm_entity_(alarm_entity),
     show_keypad_(true),status_icon_flashing_(false) {
-  alarm_entity_->add_subscriber(this);
+  alarm_entity_->add_subscriber(this,
+    entity_notify::state | entity_notify_attr(ha_attr_type::code_arm_required));
   this->status_icon_ = std::unique_ptr<AlarmIconItem>(
     new AlarmIconItem(std::string(uuid).append("_s"), icon_t::shield_off, 0x0CE6)); //green
   this->info_icon_ = std::unique_ptr<AlarmIconItem>(
     new AlarmIconItem(std::string(uuid).append("_i"), icon_t::progress_alert, 0xED80)); //orange
   this->disarm_button_ = std::unique_ptr<AlarmButtonItem>(
     new AlarmButtonItem(std::string(uuid).append("_d"), 
-      button_type::disarm, get_translation(translation_item::disarm)));
+      button_type::disarm, get_translation(static_translation::disarm)));
 }
 
 AlarmCard::~AlarmCard() {
@@ -109,21 +112,27 @@ bool AlarmCard::add_arm_button(alarm_arm_action action) {
   }
 
   const char *action_type = nullptr;
+  static_translation label = static_translation::arm_home;
   switch(action) {
     case alarm_arm_action::arm_home:
       action_type = button_type::armHome;
+      label = static_translation::arm_home;
       break;
     case alarm_arm_action::arm_away:
       action_type = button_type::armAway;
+      label = static_translation::arm_away;
       break;
     case alarm_arm_action::arm_night:
       action_type = button_type::armNight;
+      label = static_translation::arm_night;
       break;
     case alarm_arm_action::arm_vacation:
       action_type = button_type::armVacation;
+      label = static_translation::arm_vacation;
       break;
     case alarm_arm_action::arm_custom_bypass:
       action_type = button_type::armCustomBypass;
+      label = static_translation::arm_custom_bypass;
       break;
   }
 
@@ -131,7 +140,7 @@ bool AlarmCard::add_arm_button(alarm_arm_action action) {
     std::unique_ptr<AlarmButtonItem>(
       new AlarmButtonItem(
         std::string(this->uuid_).append(1, '_').append(action_type), 
-        action_type, get_translation(action_type))));
+        action_type, get_translation(label))));
   return true;
 }
 
@@ -208,7 +217,8 @@ ThermoCard::ThermoCard(const std::string &uuid,
     Card(page_type::cardThermo, uuid),
     thermo_entity_(thermo_entity) {
   this->configure_temperature_unit();
-  thermo_entity->add_subscriber(this);
+  // note: the card reads the entity when rendering so no notifications are required
+  thermo_entity->add_subscriber(this, entity_notify::none);
 }
 
 ThermoCard::ThermoCard(const std::string &uuid,
@@ -217,7 +227,7 @@ ThermoCard::ThermoCard(const std::string &uuid,
     Card(page_type::cardThermo, uuid, title),
     thermo_entity_(thermo_entity) {
   this->configure_temperature_unit();
-  thermo_entity->add_subscriber(this);
+  thermo_entity->add_subscriber(this, entity_notify::none);
 }
 
 ThermoCard::ThermoCard(
@@ -227,7 +237,7 @@ ThermoCard::ThermoCard(
     Card(page_type::cardThermo, uuid, title, sleep_timeout),
     thermo_entity_(thermo_entity) {
   this->configure_temperature_unit();
-  thermo_entity->add_subscriber(this);
+  thermo_entity->add_subscriber(this, entity_notify::none);
 }
 
 ThermoCard::~ThermoCard() {
@@ -262,24 +272,18 @@ std::string &ThermoCard::render(std::string &buffer) {
   buffer.append(Configuration::get_temperature_unit_str());
   buffer.append(1, SEPARATOR);
 
-  std::string dest_temp_str = 
-    this->thermo_entity_->get_attribute(ha_attr_type::temperature);
-  std::string dest_temp2_str;
-
-  if (dest_temp_str.empty()) {
-    dest_temp_str = this->thermo_entity_->get_attribute(
-      ha_attr_type::target_temp_high, "0");
-    dest_temp2_str = this->thermo_entity_->get_attribute(
-      ha_attr_type::target_temp_low);
-    if (!dest_temp2_str.empty()) {
-      dest_temp2_str = std::to_string(
-        static_cast<int>(std::stof(dest_temp2_str) * 10));
-    }
+  // target temperatures (in tenths), high/low are used when there is no single target
+  int32_t dest_temp = 0, dest_temp2 = 0;
+  bool has_dest_temp2 = false;
+  if (!parse_fixed(this->thermo_entity_->get_attribute(
+      ha_attr_type::temperature), 1, dest_temp)) {
+    dest_temp = fixed_or_default(this->thermo_entity_->get_attribute(
+      ha_attr_type::target_temp_high), 1, 0);
+    has_dest_temp2 = parse_fixed(this->thermo_entity_->get_attribute(
+      ha_attr_type::target_temp_low), 1, dest_temp2);
   }
-  dest_temp_str = std::to_string(
-    static_cast<int>(std::stof(dest_temp_str) * 10));
 
-  buffer.append(dest_temp_str).append(1, SEPARATOR);
+  append_number(buffer, dest_temp).append(1, SEPARATOR);
 
   auto hvac_action = this->thermo_entity_->get_attribute(
     ha_attr_type::hvac_action);
@@ -296,19 +300,16 @@ std::string &ThermoCard::render(std::string &buffer) {
   }
   buffer.append(1, SEPARATOR);
 
-  buffer.append(std::to_string(static_cast<int>(
-    std::stof(this->thermo_entity_->get_attribute(
-      ha_attr_type::min_temp, "0")) * 10)));
+  append_number(buffer, fixed_or_default(
+    this->thermo_entity_->get_attribute(ha_attr_type::min_temp), 1, 0));
   buffer.append(1, SEPARATOR);
 
-  buffer.append(std::to_string(static_cast<int>(
-    std::stof(this->thermo_entity_->get_attribute(
-      ha_attr_type::max_temp, "0")) * 10)));
+  append_number(buffer, fixed_or_default(
+    this->thermo_entity_->get_attribute(ha_attr_type::max_temp), 1, 0));
   buffer.append(1, SEPARATOR);
 
-  buffer.append(std::to_string(static_cast<int>(
-    std::stof(this->thermo_entity_->get_attribute(
-      ha_attr_type::target_temp_step, "0.5")) * 10)));
+  append_number(buffer, fixed_or_default(
+    this->thermo_entity_->get_attribute(ha_attr_type::target_temp_step), 1, 5));
   
   //TODO: add overwrite_supported_modes
   auto& hvac_modes_str = 
@@ -335,7 +336,7 @@ std::string &ThermoCard::render(std::string &buffer) {
       }
       buffer.append(1, SEPARATOR);
       buffer.append(get_icon(CLIMATE_ICON_MAP, mode)).append(1, SEPARATOR);
-      buffer.append(std::to_string(active_colour)).append(1, SEPARATOR);
+      append_number(buffer, active_colour).append(1, SEPARATOR);
       buffer.append(1, this->thermo_entity_->is_state(mode) ? '1' : '0');
       buffer.append(1, SEPARATOR);
       buffer.append(mode);
@@ -347,12 +348,13 @@ std::string &ThermoCard::render(std::string &buffer) {
 
   buffer.append(1, SEPARATOR);
 
-  buffer.append(get_translation(translation_item::currently)).append(1, SEPARATOR);
-  buffer.append(get_translation(translation_item::state)).append(1, SEPARATOR);
+  buffer.append(get_translation(static_translation::currently)).append(1, SEPARATOR);
+  buffer.append(get_translation(static_translation::state)).append(1, SEPARATOR);
   // buffer.append(get_translation(translation_item::action)).append(1, SEPARATOR); // depreciated
   buffer.append(1, SEPARATOR);
   buffer.append(this->temperature_unit_icon_).append(1, SEPARATOR);
-  buffer.append(dest_temp2_str).append(1, SEPARATOR);
+  if (has_dest_temp2) append_number(buffer, dest_temp2);
+  buffer.append(1, SEPARATOR);
   
   if (this->thermo_entity_->has_attribute(ha_attr_type::preset_modes) || 
       this->thermo_entity_->has_attribute(ha_attr_type::swing_modes) || 
@@ -373,7 +375,8 @@ MediaCard::MediaCard(const std::string &uuid,
     const std::shared_ptr<Entity> &media_entity) :
     Card(page_type::cardMedia, uuid),
     media_entity_(media_entity) {
-  media_entity->add_subscriber(this);
+  // note: the card reads the entity when rendering so no notifications are required
+  media_entity->add_subscriber(this, entity_notify::none);
 }
 
 MediaCard::MediaCard(const std::string &uuid,
@@ -381,7 +384,7 @@ MediaCard::MediaCard(const std::string &uuid,
     const std::string &title) :
     Card(page_type::cardMedia, uuid, title),
     media_entity_(media_entity) {
-  media_entity->add_subscriber(this);
+  media_entity->add_subscriber(this, entity_notify::none);
 }
 
 MediaCard::MediaCard(const std::string &uuid,
@@ -389,7 +392,7 @@ MediaCard::MediaCard(const std::string &uuid,
     const std::string &title, const uint16_t sleep_timeout) :
     Card(page_type::cardMedia, uuid, title, sleep_timeout),
     media_entity_(media_entity) {
-  media_entity->add_subscriber(this);
+  media_entity->add_subscriber(this, entity_notify::none);
 }
 
 MediaCard::~MediaCard() {
@@ -418,9 +421,8 @@ std::string &MediaCard::render(std::string &buffer) {
     ha_attr_type::media_artist).substr(0, 40));
   buffer.append(2, SEPARATOR);
 
-  buffer.append(std::to_string(
-    static_cast<uint8_t>(std::stof(this->media_entity_->get_attribute(
-      ha_attr_type::volume_level, "0")) * 100.0f)));
+  append_number(buffer, static_cast<uint8_t>(fixed_or_default(
+    this->media_entity_->get_attribute(ha_attr_type::volume_level), 2, 0)));
   buffer.append(1, SEPARATOR);
 
   auto icon = this->media_entity_->is_state(entity_state::playing)
@@ -433,9 +435,9 @@ std::string &MediaCard::render(std::string &buffer) {
   // on/off button colour
   if (supported_features & 0b10000000) {
     if (this->media_entity_->is_state(entity_state::off))
-      buffer.append(std::to_string(1374)); // light blue
+      buffer.append("1374"); // light blue
     else
-      buffer.append(std::to_string(64704)); // orange
+      buffer.append("64704"); // orange
   } else {
     buffer.append(generic_type::disable);
   }
@@ -462,7 +464,7 @@ std::string &MediaCard::render(std::string &buffer) {
     this->media_entity_->get_attribute(ha_attr_type::media_content_type),
     icon_t::speaker_off);
   buffer.append(media_icon).append(1, SEPARATOR);
-  buffer.append(std::to_string(17299U)).append(2, SEPARATOR);
+  buffer.append("17299").append(2, SEPARATOR);
   
   for (auto& item : this->items_) {
     buffer.append(1, SEPARATOR).append(item->render());
@@ -16,6 +16,20 @@ constexpr char SEPARATOR = '~';
 // workaround for https://github.com/sairon/esphome-nspanel-lovelace-ui/issues/8
 constexpr uint8_t COMMAND_COOLDOWN = 75u;
 constexpr uint16_t DEFAULT_SLEEP_TIMEOUT_S = 20u;
+// The initial HA state sync is complete when no updates arrive for this period (ms)
+constexpr uint16_t HA_SYNC_QUIET_PERIOD = 500u;
+// Ends the initial HA state sync even when noisy entities keep it busy (ms)
+constexpr uint16_t HA_SYNC_MAX_DURATION = 10000u;
+// The default time repeated input events from a control are coalesced for (ms)
+constexpr uint16_t DEFAULT_INPUT_INTERVAL = 200u;
+// Optimistic entity updates are rolled back when HA doesn't confirm them within this time (ms)
+constexpr uint16_t OPTIMISTIC_UPDATE_TIMEOUT = 3000u;
+// The time after the last input the popup fields a control owns show the input value (ms)
+constexpr uint16_t ACTIVE_CONTROL_WINDOW = 1500u;
+// The minimum time between service calls with the same entity, service and parameter (ms)
+constexpr uint16_t SERVICE_CALL_MIN_SPACING = 100u;
+// A service call is no longer in flight after this time even if HA didn't send an update (ms)
+constexpr uint16_t SERVICE_CALL_IN_FLIGHT_TIMEOUT = 1000u;
 // Change this value when the state object structure changes
 constexpr uint32_t RESTORE_STATE_VERSION = 0xA62E0210;
 
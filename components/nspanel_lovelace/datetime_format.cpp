@@ -0,0 +1,225 @@
+#include "datetime_format.h"
+#include "translations.h"
+
+#include <array>
+#include <cctype>
+#include <cstring>
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+namespace {
+
+constexpr std::array<static_translation, 7> WEEKDAY_NAMES = {
+  static_translation::dow_sunday, static_translation::dow_monday,
+  static_translation::dow_tuesday, static_translation::dow_wednesday,
+  static_translation::dow_thursday, static_translation::dow_friday,
+  static_translation::dow_saturday};
+constexpr std::array<static_translation, 7> WEEKDAY_ABBRS = {
+  static_translation::dow_sun, static_translation::dow_mon,
+  static_translation::dow_tue, static_translation::dow_wed,
+  static_translation::dow_thu, static_translation::dow_fri,
+  static_translation::dow_sat};
+constexpr std::array<static_translation, 12> MONTH_NAMES = {
+  static_translation::month_january, static_translation::month_february,
+  static_translation::month_march, static_translation::month_april,
+  static_translation::month_may, static_translation::month_june,
+  static_translation::month_july, static_translation::month_august,
+  static_translation::month_september, static_translation::month_october,
+  static_translation::month_november, static_translation::month_december};
+constexpr std::array<static_translation, 12> MONTH_ABBRS = {
+  static_translation::month_jan, static_translation::month_feb,
+  static_translation::month_mar, static_translation::month_apr,
+  static_translation::month_may, static_translation::month_jun,
+  static_translation::month_jul, static_translation::month_aug,
+  static_translation::month_sep, static_translation::month_oct,
+  static_translation::month_nov, static_translation::month_dec};
+
+void append_strftime(std::string &buffer, const char *format, const struct tm &time) {
+  char buff[64];
+  auto length = strftime(buff, sizeof(buff), format, &time);
+  buffer.append(buff, length);
+}
+
+template<size_t N>
+void append_name(std::string &buffer, const std::array<static_translation, N> &names,
+    int index, const char *format, const struct tm &time) {
+  // note: names are empty when there is no translation (e.g. english)
+  if (index >= 0 && index < static_cast<int>(N)) {
+    const char *name = get_translation(names[index]);
+    if (name != nullptr && name[0] != '\0') {
+      buffer.append(name);
+      return;
+    }
+  }
+  append_strftime(buffer, format, time);
+}
+
+void append_2digits(std::string &buffer, int value, char pad = '0') {
+  if (value < 0 || value > 99) value = 0;
+  buffer.push_back(value < 10 ? pad : static_cast<char>('0' + value / 10));
+  buffer.push_back(static_cast<char>('0' + value % 10));
+}
+
+// Formats which strftime expands to other conversions
+const char *get_expansion(char conversion) {
+  switch (conversion) {
+    case 'c': return "%a %b %e %H:%M:%S %Y";
+    case 'D': return "%m/%d/%y";
+    case 'F': return "%Y-%m-%d";
+    case 'r': return "%I:%M:%S %p";
+    case 'R': return "%H:%M";
+    case 'T': return "%H:%M:%S";
+    default: return nullptr;
+  }
+}
+
+} // namespace
+
+void DateTimeFormat::compile(const std::string &format) {
+  this->tokens_.clear();
+  this->literals_.clear();
+  this->compile_(format.c_str(), format.c_str() + format.size());
+  this->tokens_.shrink_to_fit();
+  this->literals_.shrink_to_fit();
+}
+
+void DateTimeFormat::compile_(const char *pos, const char *end) {
+  while (pos < end) {
+    if (*pos != '%' || pos + 1 == end) {
+      const char *start = pos++;
+      while (pos < end && *pos != '%') pos++;
+      this->add_literal_(start, pos - start);
+      continue;
+    }
+    const char *start = pos++;
+    // flags, widths and E/O modifiers are left to strftime
+    while (pos + 1 < end && (std::strchr("_-0^#EO", *pos) != nullptr ||
+        std::isdigit(static_cast<unsigned char>(*pos)))) {
+      pos++;
+    }
+    const char conversion = *pos++;
+    if (pos - start > 2) {
+      this->add_token_(token_type::strftime, start, pos - start);
+      continue;
+    }
+    const char *expansion = get_expansion(conversion);
+    if (expansion != nullptr) {
+      this->compile_(expansion, expansion + std::strlen(expansion));
+      continue;
+    }
+    switch (conversion) {
+      case '%': this->add_literal_("%", 1); break;
+      case 'n': this->add_literal_("\n", 1); break;
+      case 't': this->add_literal_("\t", 1); break;
+      case 'A': this->add_token_(token_type::weekday_name); break;
+      case 'a': this->add_token_(token_type::weekday_abbr); break;
+      case 'B': this->add_token_(token_type::month_name); break;
+      case 'b':
+      case 'h': this->add_token_(token_type::month_abbr); break;
+      case 'd': this->add_token_(token_type::day); break;
+      case 'e': this->add_token_(token_type::day_padded); break;
+      case 'H': this->add_token_(token_type::hour); break;
+      case 'I': this->add_token_(token_type::hour_12); break;
+      case 'M': this->add_token_(token_type::minute); break;
+      case 'S': this->add_token_(token_type::second); break;
+      case 'm': this->add_token_(token_type::month); break;
+      case 'Y': this->add_token_(token_type::year); break;
+      case 'y': this->add_token_(token_type::year_short); break;
+      case 'p': this->add_token_(token_type::am_pm); break;
+      default: this->add_token_(token_type::strftime, start, pos - start); break;
+    }
+  }
+}
+
+void DateTimeFormat::add_literal_(const char *str, size_t length) {
+  if (length == 0) return;
+  // merge consecutive literals (e.g. "%%" followed by text)
+  if (!this->tokens_.empty()) {
+    auto &last = this->tokens_.back();
+    if (last.type == token_type::literal &&
+        last.offset + last.length == this->literals_.size()) {
+      this->literals_.append(str, length);
+      last.length += length;
+      return;
+    }
+  }
+  this->add_token_(token_type::literal, str, length);
+}
+
+void DateTimeFormat::add_token_(token_type type, const char *str, size_t length) {
+  Token token{type, 0, 0};
+  if (str != nullptr) {
+    token.offset = this->literals_.size();
+    token.length = length;
+    this->literals_.append(str, length);
+    // strftime needs a null terminated format
+    if (type == token_type::strftime) this->literals_.push_back('\0');
+  }
+  this->tokens_.push_back(token);
+}
+
+void DateTimeFormat::format(const struct tm &time, std::string &buffer) const {
+  for (const auto &token : this->tokens_) {
+    switch (token.type) {
+      case token_type::literal:
+        buffer.append(this->literals_, token.offset, token.length);
+        break;
+      case token_type::strftime:
+        append_strftime(buffer, this->literals_.c_str() + token.offset, time);
+        break;
+      case token_type::weekday_name:
+        append_name(buffer, WEEKDAY_NAMES, time.tm_wday, "%A", time);
+        break;
+      case token_type::weekday_abbr:
+        append_name(buffer, WEEKDAY_ABBRS, time.tm_wday, "%a", time);
+        break;
+      case token_type::month_name:
+        append_name(buffer, MONTH_NAMES, time.tm_mon, "%B", time);
+        break;
+      case token_type::month_abbr:
+        append_name(buffer, MONTH_ABBRS, time.tm_mon, "%b", time);
+        break;
+      case token_type::day:
+        append_2digits(buffer, time.tm_mday);
+        break;
+      case token_type::day_padded:
+        append_2digits(buffer, time.tm_mday, ' ');
+        break;
+      case token_type::hour:
+        append_2digits(buffer, time.tm_hour);
+        break;
+      case token_type::hour_12:
+        append_2digits(buffer, time.tm_hour % 12 == 0 ? 12 : time.tm_hour % 12);
+        break;
+      case token_type::minute:
+        append_2digits(buffer, time.tm_min);
+        break;
+      case token_type::second:
+        append_2digits(buffer, time.tm_sec);
+        break;
+      case token_type::month:
+        append_2digits(buffer, time.tm_mon + 1);
+        break;
+      case token_type::year: {
+        const int year = time.tm_year + 1900;
+        if (year < 0 || year > 9999) {
+          append_strftime(buffer, "%Y", time);
+          break;
+        }
+        append_2digits(buffer, year / 100);
+        append_2digits(buffer, year % 100);
+        break;
+      }
+      case token_type::year_short:
+        append_2digits(buffer, ((time.tm_year + 1900) % 100 + 100) % 100);
+        break;
+      case token_type::am_pm:
+        buffer.append(time.tm_hour < 12 ? "AM" : "PM");
+        break;
+    }
+  }
+}
+
+} // namespace nspanel_lovelace
+} // namespace esphome
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <time.h>
+#include <vector>
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+// A strftime format compiled into literal spans and conversion tokens.
+// Day and month names are taken from the translations so no locale is
+// needed, names without a translation (e.g. english) use strftime.
+// see: https://esphome.io/components/time/#strftime
+class DateTimeFormat {
+public:
+  DateTimeFormat() = default;
+  explicit DateTimeFormat(const std::string &format) { this->compile(format); }
+
+  void compile(const std::string &format);
+  // Appends the formatted time to the buffer
+  void format(const struct tm &time, std::string &buffer) const;
+
+  bool empty() const { return this->tokens_.empty(); }
+
+protected:
+  enum class token_type : uint8_t {
+    literal,
+    // conversions without a dedicated token, formatted by strftime
+    strftime,
+    weekday_name,
+    weekday_abbr,
+    month_name,
+    month_abbr,
+    day,            // %d
+    day_padded,     // %e
+    hour,           // %H
+    hour_12,        // %I
+    minute,         // %M
+    second,         // %S
+    month,          // %m
+    year,           // %Y
+    year_short,     // %y
+    am_pm,          // %p
+  };
+  struct Token {
+    token_type type;
+    // the span in literals_ (literal and strftime tokens only)
+    uint16_t offset;
+    uint16_t length;
+  };
+
+  void compile_(const char *pos, const char *end);
+  void add_literal_(const char *str, size_t length);
+  void add_token_(token_type type, const char *str = nullptr, size_t length = 0);
+
+  std::vector<Token> tokens_;
+  std::string literals_;
+};
+
+} // namespace nspanel_lovelace
+} // namespace esphome
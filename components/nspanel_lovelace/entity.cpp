@@ -1,5 +1,10 @@
 #include "entity.h"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "esphome/core/hal.h"
+
 namespace esphome {
 namespace nspanel_lovelace {
 
@@ -17,23 +22,30 @@ Entity::Entity(const std::string &entity_id, const char *type) :
   enable_notifications_ = true;
 }
 
-void Entity::add_subscriber(IEntitySubscriber *const target) {
+void Entity::add_subscriber(IEntitySubscriber *const target, entity_notify_mask_t mask) {
   // for (auto t : this->targets_) {
-  //     if (t == target) return;
+  //     if (t.target == target) return;
   // }
-  this->targets_.push_back(target);
+  this->targets_.push_back({target, mask});
 }
 
 bool Entity::remove_subscriber(const IEntitySubscriber *const target) {
   for (auto iter = this->targets_.begin(); iter != this->targets_.end(); ++iter) {
-    if (*iter == target) {
+    if (iter->target == target) {
       this->targets_.erase(iter);
       return true;
     }
   }
-  // this->targets_.erase(
-  //     std::remove(this->targets_.begin(), this->targets_.end(), target),
-  //     this->targets_.end());
+  return false;
+}
+
+bool Entity::set_subscriber_mask(const IEntitySubscriber *const target, entity_notify_mask_t mask) {
+  for (auto &t : this->targets_) {
+    if (t.target == target) {
+      t.mask = mask;
+      return true;
+    }
+  }
   return false;
 }
 
@@ -86,44 +98,185 @@ bool Entity::is_state(const std::string &state) const { return this->state_ == s
 
 const std::string &Entity::get_state() const { return this->state_; }
 
-void Entity::set_state(const std::string &state) {
-  if (this->state_ == state) return;
+entity_state_result Entity::set_state(const std::string &state) {
+  if (this->state_ == state) return entity_state_result::unchanged;
   this->state_ = state;
+  return this->on_state_set_();
+}
 
-  if (this->enable_notifications_) {
-    this->notify_state_change(state);
+entity_state_result Entity::set_state(std::string &&state) {
+  if (this->state_ == state) return entity_state_result::unchanged;
+  this->state_ = std::move(state);
+  return this->on_state_set_();
+}
+
+entity_state_result Entity::on_state_set_() {
+  if (!this->enable_notifications_) return entity_state_result::notified;
+
+  if (this->state_filter_ != nullptr) {
+    auto result = this->apply_state_filter_(this->state_);
+    if (result != entity_state_result::notified) return result;
+  }
+  this->notify_state_change(this->state_);
+  return entity_state_result::notified;
+}
+
+void Entity::set_state_filter(int8_t precision, float deadband,
+    float deadband_relative, uint32_t min_interval_ms) {
+  this->state_filter_.reset(new StateFilter{
+    {precision, deadband, deadband_relative, min_interval_ms}, NAN, 0, false});
+}
+
+uint32_t Entity::get_state_filter_delay() const {
+  if (this->state_filter_ == nullptr) return 0;
+  auto elapsed = millis() - this->state_filter_->last_notify_ms;
+  auto interval = this->state_filter_->config.min_interval_ms;
+  return elapsed >= interval ? 0 : interval - elapsed;
+}
+
+bool Entity::flush_state() {
+  if (this->state_filter_ == nullptr || !this->state_filter_->pending)
+    return false;
+  auto filter = this->state_filter_.get();
+  float value;
+  filter->last_value = parse_float(this->state_, value) ? value : NAN;
+  filter->last_notify_ms = millis();
+  filter->pending = false;
+  this->notify_state_change(this->state_);
+  return true;
+}
+
+entity_state_result Entity::apply_state_filter_(const std::string &state) {
+  auto filter = this->state_filter_.get();
+  auto &config = filter->config;
+  auto now = millis();
+
+  // note: parse_float rejects 'nan' and 'inf' so the comparisons below are always valid
+  float value;
+  bool is_numeric = parse_float(state, value);
+
+  // non-numeric states (e.g. 'unavailable') are never filtered
+  if (is_numeric && !std::isnan(filter->last_value)) {
+    if (config.precision >= 0) {
+      float scale = std::pow(10.0f, config.precision);
+      if (std::lround(value * scale) == std::lround(filter->last_value * scale)) {
+        filter->pending = false;
+        return entity_state_result::filtered;
+      }
+    }
+    float threshold = std::max(config.deadband,
+      config.deadband_relative * std::fabs(filter->last_value));
+    if (std::fabs(value - filter->last_value) < threshold) {
+      filter->pending = false;
+      return entity_state_result::filtered;
+    }
+    if (now - filter->last_notify_ms < config.min_interval_ms) {
+      filter->pending = true;
+      return entity_state_result::rate_limited;
+    }
+  }
+
+  filter->last_value = is_numeric ? value : NAN;
+  filter->last_notify_ms = now;
+  filter->pending = false;
+  return entity_state_result::notified;
+}
+
+static bool is_pooled_attribute(ha_attr_type attr) {
+  switch (attr) {
+    case ha_attr_type::device_class:
+    case ha_attr_type::unit_of_measurement:
+    case ha_attr_type::supported_color_modes:
+    case ha_attr_type::effect_list:
+    case ha_attr_type::temperature_unit:
+    case ha_attr_type::preset_modes:
+    case ha_attr_type::swing_modes:
+    case ha_attr_type::fan_modes:
+    case ha_attr_type::hvac_modes:
+    case ha_attr_type::source_list:
+    case ha_attr_type::options:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Attributes which are converted before being stored
+static bool is_converted_attribute(ha_attr_type attr) {
+  switch (attr) {
+    case ha_attr_type::brightness:
+    case ha_attr_type::color_temp:
+    case ha_attr_type::supported_color_modes:
+    case ha_attr_type::effect_list:
+    case ha_attr_type::preset_modes:
+    case ha_attr_type::swing_modes:
+    case ha_attr_type::fan_modes:
+    case ha_attr_type::hvac_modes:
+    case ha_attr_type::source_list:
+    case ha_attr_type::options:
+      return true;
+    default:
+      return false;
   }
 }
 
+static bool is_epoch_attribute(ha_attr_type attr) {
+  return attr == ha_attr_type::finishes_at;
+}
+
 bool Entity::has_attribute(ha_attr_type attr) const {
+  if (is_pooled_attribute(attr)) {
+    return this->pooled_attributes_.find(attr) != this->pooled_attributes_.end();
+  }
   auto it = attributes_.find(attr);
   return it != attributes_.end();
 }
 
+const std::string &Entity::get_attribute(ha_attr_type attr) const {
+  static const std::string empty_str;
+  return this->get_attribute(attr, empty_str);
+}
+
 const std::string &Entity::get_attribute(ha_attr_type attr, const std::string &default_value) const {
+  if (is_pooled_attribute(attr)) {
+    auto it = this->pooled_attributes_.find(attr);
+    return it == this->pooled_attributes_.end() ? default_value : it->second.str();
+  }
   auto it = attributes_.find(attr);
   return it == attributes_.end() ? default_value : it->second;
 }
 
 void Entity::set_attribute(ha_attr_type attr, const std::string &value) {
+  const bool pooled = is_pooled_attribute(attr);
+  if (is_epoch_attribute(attr)) this->update_attribute_epoch_(attr, value);
   if (value.empty() || value == "None" || value == "none") {
-    attributes_.erase(attr);
+    if (pooled) {
+      this->pooled_attributes_.erase(attr);
+    } else {
+      attributes_.erase(attr);
+    }
     this->notify_attribute_change(attr, "");
     return;
   }
-  if (this->attributes_[attr] == value) return;
+  if (this->get_attribute(attr) == value) return;
+
+  // pooled values are built in a temporary string before being interned
+  std::string pooled_value;
+  auto &new_value = pooled ? pooled_value : this->attributes_[attr];
 
   if (attr == ha_attr_type::brightness) {
-    this->attributes_[attr] = std::to_string(static_cast<int>(round(
-        scale_value(std::stoi(value), {0, 255}, {0, 100}))));
+    new_value.clear();
+    append_number(new_value, static_cast<int>(round(
+        scale_value(value_or_default(value, 0.0f), {0, 255}, {0, 100}))));
   } else if (attr == ha_attr_type::color_temp) {
-    auto &minstr = this->get_attribute(ha_attr_type::min_mireds);
-    auto &maxstr = this->get_attribute(ha_attr_type::max_mireds);
-    uint16_t min_mireds = minstr.empty() ? 153 : std::stoi(minstr);
-    uint16_t max_mireds = maxstr.empty() ? 500 : std::stoi(maxstr);
-    this->attributes_[attr] = std::to_string(static_cast<int>(round(scale_value(
-        std::stoi(value),
-        {static_cast<double>(min_mireds), static_cast<double>(max_mireds)},
+    uint16_t min_mireds = value_or_default(
+      this->get_attribute(ha_attr_type::min_mireds), 153U);
+    uint16_t max_mireds = value_or_default(
+      this->get_attribute(ha_attr_type::max_mireds), 500U);
+    new_value.clear();
+    append_number(new_value, static_cast<int>(round(scale_value(
+        value_or_default(value, 0.0f),
+        {static_cast<float>(min_mireds), static_cast<float>(max_mireds)},
         {0, 100}))));
   } else if (attr == ha_attr_type::supported_color_modes ||
       attr == ha_attr_type::effect_list ||
@@ -136,40 +289,109 @@ void Entity::set_attribute(ha_attr_type attr, const std::string &value) {
       attr == ha_attr_type::source_list ||
       attr == ha_attr_type::options) {
     // todo: remove this when esphome starts sending properly formatted array strings
-    this->attributes_[attr] = convert_python_arr_str(value);
+    new_value = convert_python_arr_str(value);
     
     // only store the first 14 effects as additonal ones will never be rendered
     if (attr == ha_attr_type::effect_list) {
-      auto split_pos = find_nth_of(',', 15, this->attributes_[attr]);
+      auto split_pos = find_nth_of(',', 15, new_value);
       if (split_pos != std::string::npos) {
-        this->attributes_[attr] = this->attributes_[attr].substr(0, split_pos);
+        new_value.resize(split_pos);
       }
     }
-    this->attributes_[attr].shrink_to_fit();
   } else {
-    this->attributes_[attr] = value;
+    new_value = value;
+  }
+
+  if (pooled) {
+    // note: the pool stores a copy sized to fit, so no shrink_to_fit is required
+    this->pooled_attributes_[attr] = PooledString(pooled_value);
   }
 
   if (this->enable_notifications_) {
-    this->notify_attribute_change(attr, this->attributes_[attr]);
+    this->notify_attribute_change(attr, this->get_attribute(attr));
   }
 }
 
+void Entity::set_attribute(ha_attr_type attr, std::string &&value) {
+  // converted and pooled values are rebuilt so there is nothing to move
+  if (is_pooled_attribute(attr) || is_converted_attribute(attr) ||
+      value.empty() || value == "None" || value == "none") {
+    this->set_attribute(attr, static_cast<const std::string &>(value));
+    return;
+  }
+  auto &current = this->attributes_[attr];
+  if (current == value) return;
+  if (is_epoch_attribute(attr)) this->update_attribute_epoch_(attr, value);
+  current = std::move(value);
+
+  if (this->enable_notifications_) {
+    this->notify_attribute_change(attr, current);
+  }
+}
+
+void Entity::restore_attribute(ha_attr_type attr, const std::string &value) {
+  if (is_pooled_attribute(attr) || !is_converted_attribute(attr) || value.empty()) {
+    this->set_attribute(attr, value);
+    return;
+  }
+  auto &current = this->attributes_[attr];
+  if (current == value) return;
+  current = value;
+
+  if (this->enable_notifications_) {
+    this->notify_attribute_change(attr, current);
+  }
+}
+
+time_t Entity::get_attribute_epoch(ha_attr_type attr) const {
+  for (auto &epoch : this->attribute_epochs_) {
+    if (epoch.first == attr) return epoch.second;
+  }
+  return 0;
+}
+
+void Entity::update_attribute_epoch_(ha_attr_type attr, const std::string &value) {
+  time_t epoch = 0;
+  if (!iso8601_to_epoch(value.c_str(), epoch)) epoch = 0;
+  for (auto &item : this->attribute_epochs_) {
+    if (item.first != attr) continue;
+    item.second = epoch;
+    return;
+  }
+  this->attribute_epochs_.push_back({attr, epoch});
+}
+
 void Entity::notify_type_change(const char *type) {
-  for (auto iter = this->targets_.begin(); iter != this->targets_.end(); ++iter) {
-    (*iter)->on_entity_type_change(type);
+  for (auto &t : this->targets_) {
+    if (!(t.mask & entity_notify::type)) {
+      this->notifications_skipped_++;
+      continue;
+    }
+    this->notifications_sent_++;
+    t.target->on_entity_type_change(type);
   }
 }
 
 void Entity::notify_state_change(const std::string &state) {
-  for (auto iter = this->targets_.begin(); iter != this->targets_.end(); ++iter) {
-    (*iter)->on_entity_state_change(state);
+  for (auto &t : this->targets_) {
+    if (!(t.mask & entity_notify::state)) {
+      this->notifications_skipped_++;
+      continue;
+    }
+    this->notifications_sent_++;
+    t.target->on_entity_state_change(state);
   }
 }
 
 void Entity::notify_attribute_change(ha_attr_type attr, const std::string &value) {
-  for (auto iter = this->targets_.begin(); iter != this->targets_.end(); ++iter) {
-    (*iter)->on_entity_attribute_change(attr, value);
+  const auto attr_mask = entity_notify_attr(attr);
+  for (auto &t : this->targets_) {
+    if (!(t.mask & attr_mask)) {
+      this->notifications_skipped_++;
+      continue;
+    }
+    this->notifications_sent_++;
+    t.target->on_entity_attribute_change(attr, value);
   }
 }
 
@@ -2,15 +2,64 @@
 
 #include <stdint.h>
 #include <string>
+#include <time.h>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "helpers.h"
+#include "string_pool.h"
 #include "types.h"
 
 namespace esphome {
 namespace nspanel_lovelace {
 
+// Bitmask used by subscribers to select the entity changes they want to be notified about.
+// Each ha_attr_type has its own bit, the type and state changes use the top 2 bits.
+using entity_notify_mask_t = uint64_t;
+
+struct entity_notify {
+  static constexpr entity_notify_mask_t none = 0;
+  static constexpr entity_notify_mask_t type = 1ULL << 63;
+  static constexpr entity_notify_mask_t state = 1ULL << 62;
+  static constexpr entity_notify_mask_t all_attributes = (1ULL << 62) - 1;
+  static constexpr entity_notify_mask_t all = UINT64_MAX;
+};
+
+static_assert(static_cast<uint8_t>(ha_attr_type::percentage_step) < 62,
+  "ha_attr_type has too many values for entity_notify_mask_t");
+
+inline constexpr entity_notify_mask_t entity_notify_attr(ha_attr_type attr) {
+  return 1ULL << static_cast<uint8_t>(attr);
+}
+template <typename... Attrs>
+inline constexpr entity_notify_mask_t entity_notify_attr(ha_attr_type attr, Attrs... attrs) {
+  return entity_notify_attr(attr) | entity_notify_attr(attrs...);
+}
+
+// Reduces the re-rendering caused by noisy numeric states (e.g. power sensors).
+// Filtered states are still stored but the subscribers are not notified.
+struct EntityStateFilter {
+  // the number of decimals displayed, changes which round to the same value are ignored (-1 = disabled)
+  int8_t precision = -1;
+  // ignore changes smaller than this value
+  float deadband = 0.0f;
+  // ignore changes smaller than this fraction of the last notified value
+  float deadband_relative = 0.0f;
+  // the minimum time between notifications
+  uint32_t min_interval_ms = 0;
+};
+
+enum class entity_state_result : uint8_t {
+  unchanged,
+  // the state was stored but the change was within the filter thresholds
+  filtered,
+  // the state was stored but the subscribers were notified too recently,
+  // call flush_state() once get_state_filter_delay() has passed
+  rate_limited,
+  notified
+};
+
 struct IEntitySubscriber {
 public:
   virtual ~IEntitySubscriber() {}
@@ -24,8 +73,11 @@ public:
   Entity(const std::string &entity_id);
   Entity(const std::string &entity_id, const char *type);
 
-  void add_subscriber(IEntitySubscriber *const target);
+  void add_subscriber(IEntitySubscriber *const target,
+      entity_notify_mask_t mask = entity_notify::all);
   bool remove_subscriber(const IEntitySubscriber *const target);
+  bool set_subscriber_mask(const IEntitySubscriber *const target,
+      entity_notify_mask_t mask);
 
   const std::string &get_entity_id() const;
   void set_entity_id(const std::string &entity_id);
@@ -36,21 +88,66 @@ public:
 
   bool is_state(const std::string &state) const;
   const std::string &get_state() const;
-  void set_state(const std::string &state);
+  entity_state_result set_state(const std::string &state);
+  entity_state_result set_state(std::string &&state);
+
+  void set_state_filter(int8_t precision, float deadband,
+      float deadband_relative, uint32_t min_interval_ms);
+  // The time remaining (ms) until a rate limited state can be notified
+  uint32_t get_state_filter_delay() const;
+  // Notifies the subscribers of a rate limited state, returns false if nothing was pending
+  bool flush_state();
 
   bool has_attribute(ha_attr_type attr) const;
-  const std::string &get_attribute(ha_attr_type attr, const std::string &default_value = "") const;
+  // note: returns a static empty string when the attribute isn't set so the
+  //       reference can be kept (a "" default argument would be a temporary)
+  const std::string &get_attribute(ha_attr_type attr) const;
+  const std::string &get_attribute(ha_attr_type attr, const std::string &default_value) const;
   void set_attribute(ha_attr_type attr, const std::string &value);
+  // Takes ownership of the value when it is stored without conversion
+  void set_attribute(ha_attr_type attr, std::string &&value);
+  // Sets a value previously returned by get_attribute without converting it again
+  // (e.g. brightness is stored as 0-100), used to roll back optimistic updates
+  void restore_attribute(ha_attr_type attr, const std::string &value);
+  // The UTC epoch of a date/time attribute (e.g. finishes_at), 0 if not set or unparsable
+  time_t get_attribute_epoch(ha_attr_type attr) const;
+
+  // The number of subscriber callbacks made and skipped due to the subscriber masks
+  uint32_t get_notifications_sent() const { return this->notifications_sent_; }
+  uint32_t get_notifications_skipped() const { return this->notifications_skipped_; }
 
 protected:
+  struct Subscriber {
+    IEntitySubscriber *target;
+    entity_notify_mask_t mask;
+  };
+
   std::string entity_id_;
   const char *type_;
   bool type_overridden_ = false;
   std::string state_;
   std::map<ha_attr_type, std::string> attributes_;
-  std::vector<IEntitySubscriber*> targets_;
+  // Attributes which rarely change and are often identical between entities
+  // (see is_pooled_attribute) are stored in the StringPool
+  std::map<ha_attr_type, PooledString> pooled_attributes_;
+  // Date/time attributes (see is_epoch_attribute) are parsed once when they are set
+  std::vector<std::pair<ha_attr_type, time_t>> attribute_epochs_;
+  struct StateFilter {
+    EntityStateFilter config;
+    float last_value;
+    uint32_t last_notify_ms;
+    bool pending;
+  };
+
+  std::unique_ptr<StateFilter> state_filter_;
+  std::vector<Subscriber> targets_;
   bool enable_notifications_ = false;
+  uint32_t notifications_sent_ = 0;
+  uint32_t notifications_skipped_ = 0;
 
+  entity_state_result on_state_set_();
+  entity_state_result apply_state_filter_(const std::string &state);
+  void update_attribute_epoch_(ha_attr_type attr, const std::string &value);
   void notify_type_change(const char *type);
   void notify_state_change(const std::string &state);
   void notify_attribute_change(ha_attr_type attr, const std::string &value);
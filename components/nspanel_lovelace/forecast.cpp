@@ -0,0 +1,191 @@
+#include "forecast.h"
+#include "helpers.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+namespace {
+
+// A minimal forward only scanner over a json/python formatted value
+class ForecastScanner {
+public:
+  ForecastScanner(const char *data, size_t length) :
+      pos_(data), end_(data + length) {}
+
+  bool consume(char c) {
+    this->skip_whitespace_();
+    if (this->pos_ >= this->end_ || *this->pos_ != c) return false;
+    this->pos_++;
+    return true;
+  }
+
+  // Reads a quoted string, values longer than the buffer are truncated.
+  // The buffer may be nullptr to skip the string.
+  bool read_string(char *buffer, size_t size) {
+    this->skip_whitespace_();
+    if (this->pos_ >= this->end_ || (*this->pos_ != '"' && *this->pos_ != '\''))
+      return false;
+    const char quote = *this->pos_++;
+    size_t length = 0;
+    while (this->pos_ < this->end_ && *this->pos_ != quote) {
+      char c = *this->pos_++;
+      if (c == '\\') {
+        if (this->pos_ >= this->end_) return false;
+        c = *this->pos_++;
+      }
+      if (buffer != nullptr && length + 1 < size) buffer[length++] = c;
+    }
+    if (this->pos_ >= this->end_) return false;
+    this->pos_++;
+    if (buffer != nullptr && size > 0) buffer[length] = '\0';
+    return true;
+  }
+
+  bool read_number(float &value) {
+    this->skip_whitespace_();
+    char buffer[16];
+    size_t length = 0;
+    const char *pos = this->pos_;
+    while (pos < this->end_ && length + 1 < sizeof(buffer) &&
+        (std::isdigit(static_cast<unsigned char>(*pos)) || *pos == '-' || *pos == '+' ||
+          *pos == '.' || *pos == 'e' || *pos == 'E')) {
+      buffer[length++] = *pos++;
+    }
+    if (!parse_float(buffer, length, value)) return false;
+    this->pos_ = pos;
+    return true;
+  }
+
+  // Skips a string, number, literal (e.g. null/None) or nested object/array
+  bool skip_value() {
+    this->skip_whitespace_();
+    if (this->pos_ >= this->end_) return false;
+    const char c = *this->pos_;
+    if (c == '"' || c == '\'') return this->read_string(nullptr, 0);
+    if (c != '{' && c != '[') {
+      const char *start = this->pos_;
+      while (this->pos_ < this->end_ && *this->pos_ != ',' &&
+          *this->pos_ != '}' && *this->pos_ != ']' && !is_space_(*this->pos_)) {
+        this->pos_++;
+      }
+      // a missing value (e.g. {'a': }) is malformed
+      return this->pos_ != start;
+    }
+    uint8_t depth = 0;
+    while (this->pos_ < this->end_) {
+      const char n = *this->pos_;
+      if (n == '"' || n == '\'') {
+        if (!this->read_string(nullptr, 0)) return false;
+        continue;
+      }
+      this->pos_++;
+      if (n == '{' || n == '[') {
+        depth++;
+      } else if ((n == '}' || n == ']') && --depth == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+protected:
+  const char *pos_;
+  const char *end_;
+
+  static bool is_space_(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+  void skip_whitespace_() {
+    while (this->pos_ < this->end_ && is_space_(*this->pos_)) this->pos_++;
+  }
+};
+
+} // namespace
+
+int8_t parse_forecast(const char *data, size_t length,
+    ForecastEntry *entries, uint8_t max_entries) {
+  ForecastScanner scanner(data, length);
+  if (!scanner.consume('[')) return -1;
+  if (max_entries == 0 || scanner.consume(']')) return 0;
+
+  uint8_t count = 0;
+  while (count < max_entries) {
+    auto &entry = entries[count];
+    entry = ForecastEntry{};
+    entry.temperature = NAN;
+
+    if (!scanner.consume('{')) return -1;
+    if (!scanner.consume('}')) {
+      do {
+        char key[16];
+        if (!scanner.read_string(key, sizeof(key)) || !scanner.consume(':'))
+          return -1;
+        bool valid;
+        if (std::strcmp(key, "datetime") == 0) {
+          // note: the time is parsed before the value is truncated to the entry
+          //       (e.g. 2023-08-22T21:00:00.123456+00:00 is 32 characters)
+          char datetime[40];
+          valid = scanner.read_string(datetime, sizeof(datetime));
+          if (valid) {
+            if (!iso8601_to_epoch(datetime, entry.time)) entry.time = 0;
+            const size_t datetime_length = std::min(std::strlen(datetime), sizeof(entry.datetime) - 1);
+            std::memcpy(entry.datetime, datetime, datetime_length);
+            entry.datetime[datetime_length] = '\0';
+          }
+        } else if (std::strcmp(key, "condition") == 0) {
+          valid = scanner.read_string(entry.condition, sizeof(entry.condition));
+        } else if (std::strcmp(key, "temperature") == 0) {
+          // note: the temperature can be null/None
+          valid = scanner.read_number(entry.temperature) || scanner.skip_value();
+        } else {
+          valid = scanner.skip_value();
+        }
+        if (!valid) return -1;
+      } while (scanner.consume(','));
+      if (!scanner.consume('}')) return -1;
+    }
+    count++;
+    // the remaining entries are never scanned
+    if (!scanner.consume(',')) break;
+  }
+  return count;
+}
+
+bool WeatherForecast::update(const char *data, size_t length) {
+  // keep the cached entries if the data is unparsable
+  std::array<ForecastEntry, MAX_ENTRIES> entries;
+  auto count = parse_forecast(data, length, entries.data(), MAX_ENTRIES);
+  if (count < 0) return false;
+  std::copy(entries.begin(), entries.begin() + count, this->entries_.begin());
+  this->size_ = count;
+  this->period_ = 86400;
+  if (count > 1 && this->entries_[0].time != 0 &&
+      this->entries_[1].time > this->entries_[0].time) {
+    this->period_ = this->entries_[1].time - this->entries_[0].time;
+  }
+  return true;
+}
+
+bool WeatherForecast::expire(time_t now) {
+  uint8_t expired = 0;
+  while (expired < this->size_ && this->entries_[expired].time != 0 &&
+      this->entries_[expired].time + static_cast<time_t>(this->period_) <= now) {
+    expired++;
+  }
+  if (expired == 0) return false;
+  std::move(this->entries_.begin() + expired,
+    this->entries_.begin() + this->size_, this->entries_.begin());
+  this->size_ -= expired;
+  return true;
+}
+
+time_t WeatherForecast::get_next_expiry() const {
+  if (this->size_ == 0 || this->entries_[0].time == 0) return 0;
+  return this->entries_[0].time + this->period_;
+}
+
+} // namespace nspanel_lovelace
+} // namespace esphome
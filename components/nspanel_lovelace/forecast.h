@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+// A single forecast entry, only the values rendered by the screensaver are kept
+struct ForecastEntry {
+  char datetime[32];
+  char condition[24];
+  float temperature;
+  // the start of the forecast period (UTC epoch), 0 when unknown
+  time_t time;
+};
+
+// Scans the first max_entries objects of a forecast array without building a
+// json document, parsing stops as soon as enough entries have been read.
+// Accepts json and the python formatted lists HA sends for attributes
+// (e.g. [{'datetime': '2023-08-22T21:00:00+00:00', 'condition': 'sunny', 'temperature': 21.5}]).
+// Returns the number of entries read or -1 if the data is malformed.
+int8_t parse_forecast(const char *data, size_t length,
+    ForecastEntry *entries, uint8_t max_entries);
+
+// The parsed forecast, entries are removed as their forecast period ends
+// so the screensaver can be kept current without requesting data from HA.
+class WeatherForecast {
+public:
+  static constexpr uint8_t MAX_ENTRIES = 8;
+
+  // Replaces the cached entries, returns false if the data is unparsable
+  bool update(const char *data, size_t length);
+  // Removes the entries whose period has ended, returns true if any were removed
+  bool expire(time_t now);
+  // The time (UTC epoch) the first entry expires, 0 when unknown
+  time_t get_next_expiry() const;
+
+  bool empty() const { return this->size_ == 0; }
+  uint8_t size() const { return this->size_; }
+  const ForecastEntry &at(uint8_t index) const { return this->entries_.at(index); }
+  // The time between entries in seconds (e.g. 3600 for hourly forecasts)
+  uint32_t get_period() const { return this->period_; }
+  bool is_hourly() const { return this->period_ < 86400; }
+
+protected:
+  std::array<ForecastEntry, MAX_ENTRIES> entries_;
+  uint8_t size_ = 0;
+  uint32_t period_ = 86400;
+};
+
+} // namespace nspanel_lovelace
+} // namespace esphome
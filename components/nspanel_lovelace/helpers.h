@@ -5,6 +5,7 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <ctype.h>
 #include <esp_heap_caps.h>
@@ -12,6 +13,7 @@
 #include <stdint.h>
 #include <string>
 #include <time.h>
+#include <type_traits>
 #include <vector>
 
 namespace esphome {
@@ -52,10 +54,41 @@ inline void replace_all(
   s.swap(buf);
 }
 
+// note: memchr is used for the character searches as it compares a word at a time
 inline void replace_all(std::string &s, const char oldChar, const char newChar) {
-  size_t pos = std::string::npos;
-  while ((pos = s.find(oldChar, pos + 1)) != std::string::npos) {
-    s.at(pos) = newChar;
+  if (s.empty()) return;
+  char *pos = &s[0];
+  char *const end = pos + s.size();
+  while ((pos = static_cast<char *>(std::memchr(pos, oldChar, end - pos))) != nullptr) {
+    *pos++ = newChar;
+  }
+}
+
+// The number of times the character occurs in the string
+inline size_t count_of(char c, const char *str, size_t length) {
+  size_t count = 0;
+  const char *const end = str + length;
+  while ((str = static_cast<const char *>(std::memchr(str, c, end - str))) != nullptr) {
+    count++;
+    str++;
+  }
+  return count;
+}
+
+inline size_t count_of(char c, const std::string &str) {
+  return count_of(c, str.data(), str.size());
+}
+
+// Calls fn(const char *item, size_t length) for each non-empty item of a
+// delimited string, the iteration stops when fn returns false
+template <typename F>
+inline void for_each_item(char delimiter, const char *str, size_t length, F &&fn) {
+  const char *const end = str + length;
+  while (str < end) {
+    auto next = static_cast<const char *>(std::memchr(str, delimiter, end - str));
+    if (next == nullptr) next = end;
+    if (next != str && !fn(str, static_cast<size_t>(next - str))) return;
+    str = next + 1;
   }
 }
 
@@ -63,52 +96,309 @@ inline const char* value_or_empty(const char* s) {
   return s == nullptr ? "" : s; 
 }
 
+// note: The parse_* functions never throw or allocate. The whole string must be
+//       a number (no whitespace or trailing characters), on failure false is
+//       returned and the value is left unchanged.
+
+// Reads the digits of an unsigned number, the sign is handled by the caller
+inline bool parse_unsigned_digits(const char *str, size_t length, uint32_t max, uint32_t &value) {
+  if (length == 0) return false;
+  uint32_t result = 0;
+  for (size_t i = 0; i < length; i++) {
+    const uint8_t digit = static_cast<uint8_t>(str[i] - '0');
+    if (digit > 9 || result > (max - digit) / 10) return false;
+    result = result * 10 + digit;
+  }
+  value = result;
+  return true;
+}
+
+inline bool parse_uint(const char *str, size_t length, uint32_t &value) {
+  if (str == nullptr || length == 0) return false;
+  if (*str == '+') str++, length--;
+  return parse_unsigned_digits(str, length, UINT32_MAX, value);
+}
+
+inline bool parse_int(const char *str, size_t length, int32_t &value) {
+  if (str == nullptr || length == 0) return false;
+  const bool negative = *str == '-';
+  if (negative || *str == '+') str++, length--;
+  uint32_t magnitude;
+  if (!parse_unsigned_digits(str, length,
+      negative ? static_cast<uint32_t>(INT32_MAX) + 1 : INT32_MAX, magnitude)) {
+    return false;
+  }
+  value = negative ? -static_cast<int32_t>(magnitude - 1) - 1 : static_cast<int32_t>(magnitude);
+  return true;
+}
+
+// Parses a decimal number to a fixed point integer with the given number of
+// decimals (e.g. "21.5" with 1 decimal is 215), extra decimals are rounded
+inline bool parse_fixed(const char *str, size_t length, uint8_t decimals, int32_t &value) {
+  if (str == nullptr || length == 0) return false;
+  const char *end = str + length;
+  const bool negative = *str == '-';
+  if (negative || *str == '+') str++;
+
+  int64_t result = 0;
+  bool has_digits = false, fraction = false, round_up = false;
+  uint8_t fraction_digits = 0;
+  for (; str < end; str++) {
+    if (*str == '.' && !fraction) {
+      fraction = true;
+      continue;
+    }
+    const uint8_t digit = static_cast<uint8_t>(*str - '0');
+    if (digit > 9) return false;
+    has_digits = true;
+    if (!fraction || fraction_digits < decimals) {
+      result = result * 10 + digit;
+      if (result > INT32_MAX) return false;
+      if (fraction) fraction_digits++;
+    } else if (fraction_digits++ == decimals) {
+      round_up = digit >= 5;
+    }
+  }
+  if (!has_digits) return false;
+  for (; fraction_digits < decimals; fraction_digits++) {
+    result *= 10;
+    if (result > INT32_MAX) return false;
+  }
+  if (round_up && ++result > INT32_MAX) return false;
+  value = static_cast<int32_t>(negative ? -result : result);
+  return true;
+}
+
+// Parses a decimal number with an optional exponent (e.g. "-1.5", "2e3"),
+// nan/inf and hex values are not supported
+inline bool parse_float(const char *str, size_t length, float &value) {
+  if (str == nullptr || length == 0) return false;
+  const char *end = str + length;
+  const bool negative = *str == '-';
+  if (negative || *str == '+') str++;
+
+  // up to 9 significant digits fit in the mantissa
+  uint32_t mantissa = 0;
+  uint8_t significant_digits = 0;
+  int32_t exponent = 0;
+  bool has_digits = false, fraction = false;
+  for (; str < end; str++) {
+    if (*str == '.' && !fraction) {
+      fraction = true;
+      continue;
+    }
+    const uint8_t digit = static_cast<uint8_t>(*str - '0');
+    if (digit > 9) break;
+    has_digits = true;
+    if (significant_digits < 9) {
+      mantissa = mantissa * 10 + digit;
+      if (mantissa != 0) significant_digits++;
+      if (fraction) exponent--;
+    } else if (!fraction) {
+      exponent++;
+    }
+  }
+  if (!has_digits) return false;
+  if (str < end) {
+    if (*str != 'e' && *str != 'E') return false;
+    str++;
+    int32_t exp_value;
+    if (!parse_int(str, end - str, exp_value) || exp_value < -99 || exp_value > 99) return false;
+    exponent += exp_value;
+  }
+
+  // note: multiplying/dividing by exact powers of 10 rounds correctly for up to 7
+  //       significant digits and at most 8 decimals (e.g. "21.5" is exact)
+  static constexpr float POWERS_OF_10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f};
+  float result = static_cast<float>(mantissa);
+  while (exponent > 0 && result != 0.0f) {
+    const int32_t step = exponent > 8 ? 8 : exponent;
+    result *= POWERS_OF_10[step];
+    exponent -= step;
+  }
+  while (exponent < 0 && result != 0.0f) {
+    const int32_t step = exponent < -8 ? 8 : -exponent;
+    result /= POWERS_OF_10[step];
+    exponent += step;
+  }
+  if (std::isinf(result)) return false;
+  value = negative ? -result : result;
+  return true;
+}
+
+inline bool parse_uint(const std::string &str, uint32_t &value) {
+  return parse_uint(str.data(), str.size(), value);
+}
+inline bool parse_int(const std::string &str, int32_t &value) {
+  return parse_int(str.data(), str.size(), value);
+}
+inline bool parse_fixed(const std::string &str, uint8_t decimals, int32_t &value) {
+  return parse_fixed(str.data(), str.size(), decimals, value);
+}
+inline bool parse_float(const std::string &str, float &value) {
+  return parse_float(str.data(), str.size(), value);
+}
+
 inline unsigned long value_or_default(const std::string &str, unsigned long default_value) {
-  return str.empty() || (str[0] != '-' && str[0] != '+' && !isdigit(str[0]))
-    ? default_value : std::stoul(str);
+  uint32_t value;
+  return parse_uint(str, value) ? value : default_value;
 }
 
 inline int value_or_default(const std::string &str, int default_value) {
-  return str.empty() || (str[0] != '-' && str[0] != '+' && !isdigit(str[0]))
-    ? default_value : std::stoi(str);
+  int32_t value;
+  return parse_int(str, value) ? value : default_value;
 }
 
 inline unsigned int value_or_default(const std::string &str, unsigned int default_value) {
   return value_or_default(str, static_cast<unsigned long>(default_value));
 }
 
-inline double value_or_default(const std::string &str, double default_value) {
-  return str.empty() || (str[0] != '-' && str[0] != '+' && !isdigit(str[0]))
-    ? default_value : std::stod(str);
+inline float value_or_default(const std::string &str, float default_value) {
+  float value;
+  return parse_float(str, value) ? value : default_value;
+}
+
+// The value as a fixed point integer (e.g. "21.5" with 1 decimal is 215)
+inline int32_t fixed_or_default(const std::string &str, uint8_t decimals, int32_t default_value) {
+  int32_t value;
+  return parse_fixed(str, decimals, value) ? value : default_value;
+}
+
+// note: The append_* functions format numbers straight into the buffer without
+//       temporary strings or printf, they return the buffer so calls can be chained.
+
+inline std::string &append_number(std::string &buffer, uint32_t value, bool negative = false) {
+  char digits[11];
+  char *pos = digits + sizeof(digits);
+  do {
+    *--pos = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  if (negative) *--pos = '-';
+  return buffer.append(pos, digits + sizeof(digits) - pos);
+}
+
+template <typename T>
+inline std::string &append_number(std::string &buffer, T value) {
+  static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(uint32_t),
+    "append_number only supports integers up to 32 bits");
+  if (std::is_signed<T>::value && value < 0) {
+    // note: the cast before negating is safe for INT32_MIN
+    return append_number(buffer, 0U - static_cast<uint32_t>(value), true);
+  }
+  return append_number(buffer, static_cast<uint32_t>(value));
+}
+
+// Appends a fixed point integer with the given number of decimals (0-9),
+// e.g. 215 with 1 decimal is "21.5" and -5 with 2 decimals is "-0.05"
+inline std::string &append_fixed(std::string &buffer, int32_t value, uint8_t decimals) {
+  if (decimals == 0) return append_number(buffer, value);
+  const bool negative = value < 0;
+  uint32_t magnitude = negative ? 0U - static_cast<uint32_t>(value) : value;
+  char digits[12];
+  char *pos = digits + sizeof(digits);
+  for (uint8_t i = 0; i < decimals && i < 9; i++) {
+    *--pos = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  }
+  *--pos = '.';
+  append_number(buffer, magnitude, negative);
+  return buffer.append(pos, digits + sizeof(digits) - pos);
+}
+
+// Appends the value rounded to the given number of decimals (like "%.1f")
+// note: A float times 10^4 is exact as a double, so a single round half to even
+//       gives the same digits as printf (except "-0.0" is printed as "0.0").
+inline std::string &append_float(std::string &buffer, float value, uint8_t decimals) {
+  static constexpr double SCALE[] = {1e0, 1e1, 1e2, 1e3, 1e4};
+  if (decimals < sizeof(SCALE) / sizeof(SCALE[0])) {
+    const double scaled = std::nearbyint(static_cast<double>(value) * SCALE[decimals]);
+    if (scaled > -2147483648.0 && scaled < 2147483648.0) {
+      return append_fixed(buffer, static_cast<int32_t>(scaled), decimals);
+    }
+  }
+  // nan, inf or values out of the fixed point range
+  char str[48];
+  const int length = snprintf(str, sizeof(str), "%.*f", decimals, value);
+  if (length > 0) buffer.append(str, length < static_cast<int>(sizeof(str)) ? length : sizeof(str) - 1);
+  return buffer;
+}
+
+// The number of days since 1970-01-01 for a civil date
+// see: https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+inline constexpr int32_t days_from_civil(int32_t y, uint32_t m, uint32_t d) {
+  y -= m <= 2;
+  const int32_t era = (y >= 0 ? y : y - 399) / 400;
+  const uint32_t yoe = static_cast<uint32_t>(y - era * 400);
+  const uint32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+// Reads a fixed number of digits and advances the string
+inline bool parse_fixed_digits(const char *&str, uint8_t count, int &value) {
+  value = 0;
+  for (uint8_t i = 0; i < count; i++, str++) {
+    if (*str < '0' || *str > '9') return false;
+    value = value * 10 + (*str - '0');
+  }
+  return true;
+}
+
+// The number of days in the month of the year
+inline constexpr uint8_t days_in_month(int32_t y, uint32_t m) {
+  return m == 2 ? ((y % 4 == 0 && (y % 100 != 0 || y % 400 == 0)) ? 29 : 28)
+    : (m == 4 || m == 6 || m == 9 || m == 11) ? 30 : 31;
 }
 
-inline bool iso8601_to_tm(const char* iso8601_string, tm &t) {
+// Converts an ISO 8601 date/time in the fixed layout HA uses
+// (YYYY-MM-DD[THH:MM[:SS[.ffffff]][Z|+HH:MM|-HH:MM]]) to a UTC epoch.
+// A missing time is treated as midnight and a missing offset as UTC,
+// anything else (out of range values, trailing characters) is rejected.
+// note: unlike mktime this does not depend on the TZ
+inline bool iso8601_to_epoch(const char *iso8601_string, time_t &epoch) {
   if (iso8601_string == nullptr) return false;
-  
-	// note: don't need to know the timezone
-	static constexpr const char* format = "%d-%d-%dT%d:%d:%d";// "%d-%d-%dT%d:%d:%d+%d:%d";
-
-	uint8_t parseCount = std::sscanf(iso8601_string, format, 
-		&t.tm_year, &t.tm_mon, &t.tm_mday, 
-		&t.tm_hour, &t.tm_min, &t.tm_sec
-		//&tz_hr, &tz_min
-	);
-	
-	if (parseCount < 3) {
-		return false;
-	}
-	
-	t.tm_year -= 1900;
-	t.tm_mon -= 1;
-
-  const time_t time_temp = mktime(&t);
-	if (time_temp == -1) {
-		return false;
-	}
-  // convert to utc
-  t = *gmtime(&time_temp);
-
-	return true;
+  auto str = iso8601_string;
+  int year, month, day, hour = 0, minute = 0, second = 0;
+  if (!parse_fixed_digits(str, 4, year) || *str++ != '-' ||
+      !parse_fixed_digits(str, 2, month) || *str++ != '-' ||
+      !parse_fixed_digits(str, 2, day)) {
+    return false;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > days_in_month(year, month)) return false;
+
+  int32_t offset = 0;
+  if (*str == 'T' || *str == ' ') {
+    str++;
+    if (!parse_fixed_digits(str, 2, hour) || *str++ != ':' ||
+        !parse_fixed_digits(str, 2, minute)) {
+      return false;
+    }
+    if (*str == ':' && !parse_fixed_digits(++str, 2, second)) return false;
+    // note: 60 is a leap second
+    if (hour > 23 || minute > 59 || second > 60) return false;
+    if (*str == '.') {
+      if (*++str < '0' || *str > '9') return false;
+      while (*str >= '0' && *str <= '9') str++;
+    }
+    if (*str == 'Z') {
+      str++;
+    } else if (*str == '+' || *str == '-') {
+      const bool negative = *str++ == '-';
+      int tz_hour, tz_minute = 0;
+      if (!parse_fixed_digits(str, 2, tz_hour)) return false;
+      if (*str == ':') str++;
+      if (*str != '\0' && !parse_fixed_digits(str, 2, tz_minute)) return false;
+      if (tz_hour > 23 || tz_minute > 59 || str[-1] == ':') return false;
+      offset = (tz_hour * 60 + tz_minute) * 60;
+      if (negative) offset = -offset;
+    }
+  }
+  if (*str != '\0') return false;
+
+  epoch = static_cast<time_t>(days_from_civil(year, month, day)) * 86400 +
+    hour * 3600 + minute * 60 + second - offset;
+  return true;
 }
 
 inline uint16_t rgb_dec565(uint8_t red, uint8_t green, uint8_t blue) {
@@ -117,24 +407,33 @@ inline uint16_t rgb_dec565(uint8_t red, uint8_t green, uint8_t blue) {
   return ((red >> 3) << 11) | ((green >> 2) << 5) | ((blue >> 3));
 }
 
-// note: h,s,v should all be between 0 and 1
-inline std::vector<uint8_t> hsv2rgb(double h, double s, double v) {
-  if (s <= 0.0) {
-    auto val = static_cast<uint8_t>(round(v * 255));
-    return {val,val,val};
+// Converts a value between 0 and 1 to 0-255 (rounded), NaN is 0
+inline uint8_t unit_to_uint8(float value) {
+  if (!(value > 0.0f)) return 0;
+  if (value >= 1.0f) return 255;
+  return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+// note: h,s,v should all be between 0 and 1, h wraps around (e.g. -0.25 == 0.75),
+//       a NaN or infinite hue is treated as 0 and a NaN saturation as 0
+// note: single precision as the ESP32 FPU doesn't support doubles
+inline std::array<uint8_t, 3> hsv2rgb(float h, float s, float v) {
+  if (!(s > 0.0f)) {
+    auto val = unit_to_uint8(v);
+    return {val, val, val};
   }
 
-  // h = h >= 360.0 ? 0.0 : (h / 60.0);
-  // auto i = static_cast<uint32_t>(h);
-  auto i = static_cast<uint32_t>(h * 6.0);
-  double 
-      // f = h - i,
-      f = (h * 6.0) - i,
-      p = v * (1.0 - s),
-      q = v * (1.0 - (s * f)),
-      t = v * (1.0 - (s * (1.0 - f)));
-
-  double r = 0, g = 0, b = 0;
+  float h6 = std::isfinite(h) ? (h - std::floor(h)) * 6.0f : 0.0f;
+  // note: h - floor(h) rounds to 1 for tiny negative hues
+  if (!(h6 < 6.0f)) h6 = 0.0f;
+  const auto i = static_cast<uint8_t>(h6);
+  const float
+      f = h6 - i,
+      p = v * (1.0f - s),
+      q = v * (1.0f - (s * f)),
+      t = v * (1.0f - (s * (1.0f - f)));
+
+  float r, g, b;
   switch(i)
   {
     case 0: r = v, g = t, b = p; break;
@@ -145,29 +444,33 @@ inline std::vector<uint8_t> hsv2rgb(double h, double s, double v) {
     default: r = v, g = p, b = q; break;
   }
 
-  return {
-      static_cast<uint8_t>(round(r * 255)), 
-      static_cast<uint8_t>(round(g * 255)), 
-      static_cast<uint8_t>(round(b * 255))};
+  return {unit_to_uint8(r), unit_to_uint8(g), unit_to_uint8(b)};
 }
 
-// note: x,y should be between 0 and 1, wh (width/height) default is 160
-inline std::vector<uint8_t> xy_to_rgb(double x, double y, float wh) {
-  double r = wh / 2;
-  x = round((x - r) / r * 100) / 100;
-  y = round((r - y) / r * 100) / 100;
+// note: x,y should be between 0 and wh (width/height), the default is 160.
+//       Invalid values (e.g. wh 0 or NaN) are white, the centre of the wheel.
+inline std::array<uint8_t, 3> xy_to_rgb(float x, float y, float wh) {
+  if (!(wh > 0.0f) || !std::isfinite(wh) || !std::isfinite(x) || !std::isfinite(y)) {
+    return {255, 255, 255};
+  }
+  const float r = wh / 2;
+  // the position is rounded to 2 decimals of the wheel radius
+  // note: multiplied first so half way values (e.g. 52.5) are exact
+  x = std::round((x - r) * 100.0f / r) / 100.0f;
+  y = std::round((r - y) * 100.0f / r) / 100.0f;
 
-  r = sqrt((x * x) + (y * y));
+  const float saturation = std::sqrt((x * x) + (y * y));
   return hsv2rgb(
-      std::fmod((atan2(y, x) * (180 / M_PI)), 360) / 360,
-      (r > 1 ? 0 : r),
-      1);
+      std::atan2(y, x) / (2.0f * static_cast<float>(M_PI)),
+      (saturation > 1.0f ? 0.0f : saturation),
+      1.0f);
 }
 
-inline double scale_value(double val, std::array<double, 2> scale_from, std::array<double, 2> scale_to) {
+// note: the range is multiplied before dividing so integer values scale exactly
+inline float scale_value(float val, std::array<float, 2> scale_from, std::array<float, 2> scale_to) {
   return
-      ((val - scale_from[0]) / (scale_from[1] - scale_from[0])) * 
-      (scale_to[1] - scale_to[0]) + scale_to[0];
+      (val - scale_from[0]) * (scale_to[1] - scale_to[0]) /
+      (scale_from[1] - scale_from[0]) + scale_to[0];
 }
 
 inline bool contains_value(const std::vector<std::string> &array, const char *value) {
@@ -189,31 +492,39 @@ inline static constexpr bool str_equal(const char *a, const char *b) {
   return a == b || (a != nullptr && b != nullptr && std::strcmp(a, b) == 0);
 }
 
+// Splits the string by the delimiter, empty items are skipped
 inline void split_str(char delimiter, const std::string &str, std::vector<std::string> &array, uint16_t max_items = UINT16_MAX) {
-  size_t pos_start = 0, pos_end = 0;
-  std::string item;
+  if (max_items == 0) return;
+  array.reserve(array.size() + count_of(delimiter, str) + 1);
   uint16_t item_count = 0;
-  while ((pos_end = str.find(delimiter, pos_start)) != std::string::npos) {
-    if (item_count == max_items) return;
-    item = str.substr(pos_start, pos_end - pos_start);
-    pos_start = pos_end + 1;
-    if (!item.empty()) { array.push_back(item); }
-    item_count++;
-  }
-  if (!item.empty()) { array.push_back(str.substr(pos_start)); }
+  for_each_item(delimiter, str.data(), str.size(), [&](const char *item, size_t length) {
+    array.emplace_back(item, length);
+    return ++item_count < max_items;
+  });
 }
 
-inline size_t find_nth_of(char delimiter, uint16_t count, const std::string &str) {
-  size_t pos = std::string::npos;
-  if (count == 0) return pos;
-
-  uint16_t idx = 0;
-  do {
-    pos = str.find(delimiter, pos + 1);
-    idx++;
-  } while (pos != std::string::npos && idx < count);
+// Gets an item by index (as split by split_str) without splitting the whole string
+inline bool get_item(char delimiter, const std::string &str, size_t index, std::string &item) {
+  bool found = false;
+  for_each_item(delimiter, str.data(), str.size(), [&](const char *value, size_t length) {
+    if (index-- != 0) return true;
+    item.assign(value, length);
+    found = true;
+    return false;
+  });
+  return found;
+}
 
-  return pos;
+// The position of the count'th delimiter (1 based), npos if there are fewer
+inline size_t find_nth_of(char delimiter, uint16_t count, const std::string &str) {
+  if (count == 0) return std::string::npos;
+  const char *pos = str.data();
+  const char *const end = pos + str.size();
+  while ((pos = static_cast<const char *>(std::memchr(pos, delimiter, end - pos))) != nullptr) {
+    if (--count == 0) return pos - str.data();
+    pos++;
+  }
+  return std::string::npos;
 }
 
 // Takes the string representation of a Python array (enums, strings etc) and extracts the 
@@ -221,20 +532,20 @@ inline size_t find_nth_of(char delimiter, uint16_t count, const std::string &str
 // todo: remove this when esphome starts sending properly formatted array strings
 inline std::string convert_python_arr_str(const std::string &str, const char delimiter = ',') {
   if (str.empty()) return str;
-  size_t pos_start = std::string::npos, pos_end = pos_start;
   std::string tmp;
-  do {
-      pos_start = str.find('\'', pos_end + 1);
-      if (pos_start == std::string::npos) {
-        if (tmp.back() == delimiter) tmp.pop_back();
-        break;
-      }
-      pos_end = str.find('\'', pos_start + 1);
-      if (pos_end == std::string::npos) break;
-      // ignore empty entries
-      if (pos_end - pos_start - 1 == 0) continue;
-      tmp.append(str.substr(pos_start + 1, pos_end - pos_start - 1)).append(1, delimiter);
-  } while (true);
+  tmp.reserve(str.size());
+  const char *pos = str.data();
+  const char *const end = pos + str.size();
+  while (pos < end) {
+    auto start = static_cast<const char *>(std::memchr(pos, '\'', end - pos));
+    if (start == nullptr) break;
+    auto stop = static_cast<const char *>(std::memchr(start + 1, '\'', end - start - 1));
+    if (stop == nullptr) break;
+    // ignore empty entries
+    if (stop - start > 1) tmp.append(start + 1, stop - start - 1).append(1, delimiter);
+    pos = stop + 1;
+  }
+  if (!tmp.empty()) tmp.pop_back();
   return tmp.empty() ? str : tmp;
 }
 
@@ -259,15 +570,29 @@ inline std::string to_string(const std::vector<std::string> &array,
   return output;
 }
 
-inline std::string to_string(const std::vector<uint8_t> &array, 
-    char delimiter = ',', const char prepend_char = '\0', 
+template <size_t N>
+inline std::string to_string(const std::array<uint8_t, N> &array,
+    char delimiter = ',', const char prepend_char = '\0',
     const char append_char = '\0') {
-  std::vector<std::string> str_array;
-  str_array.reserve(array.size());
-  for (auto &&value : array) {
-    str_array.push_back(std::to_string(value));
+  std::string output;
+  if (!char_printable(delimiter)) return output;
+  // max 3 digits + delimiter per value
+  output.reserve(N * 4 + 2);
+
+  if (char_printable(prepend_char)) {
+    output.append(1, prepend_char);
   }
-  return to_string(str_array, delimiter, prepend_char, append_char);
+  for (size_t i = 0; i < N; i++) {
+    if (i > 0) output.append(1, delimiter);
+    auto value = array[i];
+    if (value >= 100) output.append(1, '0' + value / 100);
+    if (value >= 10) output.append(1, '0' + (value / 10) % 10);
+    output.append(1, '0' + value % 10);
+  }
+  if (char_printable(append_char)) {
+    output.append(1, append_char);
+  }
+  return output;
 }
 
 inline bool psram_available() {
@@ -0,0 +1,62 @@
+#include "input_coalescer.h"
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+void InputCoalescer::set_interval(const std::string &button_type, uint16_t interval_ms) {
+  for (auto &interval : this->intervals_) {
+    if (interval.first == button_type) {
+      interval.second = interval_ms;
+      return;
+    }
+  }
+  this->intervals_.emplace_back(button_type, interval_ms);
+}
+
+uint16_t InputCoalescer::get_interval(const std::string &button_type) const {
+  for (auto &interval : this->intervals_) {
+    if (interval.first == button_type) return interval.second;
+  }
+  return this->default_interval_;
+}
+
+bool InputCoalescer::on_event(const std::string &id, const std::string &button_type,
+    const std::string &value, uint32_t now) {
+  this->events_received_++;
+  Control *free_control = nullptr;
+  for (auto &control : this->controls_) {
+    if (!control.active) {
+      if (free_control == nullptr) free_control = &control;
+      continue;
+    }
+    if (control.id != id) continue;
+    if (control.button_type != button_type) {
+      // another control of the same item was used (e.g. OnOff after a brightness drag),
+      // the held value would be processed after this event and undo it
+      control.active = false;
+      control.pending = false;
+      if (free_control == nullptr) free_control = &control;
+      continue;
+    }
+    // only the latest value is kept
+    control.value = value;
+    control.pending = true;
+    return false;
+  }
+
+  const uint16_t interval = this->get_interval(button_type);
+  if (interval != 0 && free_control != nullptr) {
+    free_control->id = id;
+    free_control->button_type = button_type;
+    free_control->value.clear();
+    free_control->interval = interval;
+    free_control->interval_end = now + interval;
+    free_control->active = true;
+    free_control->pending = false;
+  }
+  this->events_sent_++;
+  return true;
+}
+
+} // namespace nspanel_lovelace
+} // namespace esphome
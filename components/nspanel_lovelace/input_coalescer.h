@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+// Coalesces the repeated input events the TFT sends (e.g. while dragging a slider)
+// per control (uuid + button type). The first event is passed through immediately,
+// events received during the interval only keep the latest value which is passed
+// through when the interval ends. The interval restarts while events keep arriving
+// so a drag is sent at most once per interval and the final value is sent, unless
+// another control of the same item is used first which drops the held value.
+class InputCoalescer {
+public:
+  // The number of controls which can be coalesced at the same time,
+  // events from other controls are passed through when all are in use
+  static constexpr uint8_t MAX_CONTROLS = 4;
+
+  void set_default_interval(uint16_t interval_ms) { this->default_interval_ = interval_ms; }
+  // Overrides the interval for a button type (e.g. brightnessSlider), 0 disables coalescing
+  void set_interval(const std::string &button_type, uint16_t interval_ms);
+  uint16_t get_interval(const std::string &button_type) const;
+
+  // Returns true if the event should be processed now, otherwise the value is held
+  bool on_event(const std::string &id, const std::string &button_type,
+      const std::string &value, uint32_t now);
+
+  // Calls fn(id, button_type, value) for the held values whose interval has ended.
+  // Returns the time (ms) until the next interval ends, 0 if no controls are active.
+  template <typename F>
+  uint32_t flush(uint32_t now, F &&fn) {
+    uint32_t next_delay = 0;
+    for (auto &control : this->controls_) {
+      if (!control.active) continue;
+      if (static_cast<int32_t>(now - control.interval_end) >= 0) {
+        if (!control.pending) {
+          // idle for a whole interval, the next event is passed through immediately
+          control.active = false;
+          continue;
+        }
+        control.pending = false;
+        control.interval_end = now + control.interval;
+        this->events_sent_++;
+        fn(control.id, control.button_type, control.value);
+      }
+      const uint32_t delay = control.interval_end - now;
+      if (next_delay == 0 || delay < next_delay) next_delay = delay;
+    }
+    return next_delay;
+  }
+
+  uint32_t get_events_received() const { return this->events_received_; }
+  uint32_t get_events_sent() const { return this->events_sent_; }
+
+protected:
+  struct Control {
+    std::string id;
+    std::string button_type;
+    std::string value;
+    uint32_t interval_end = 0;
+    uint16_t interval = 0;
+    bool active = false;
+    // a value was received during the interval
+    bool pending = false;
+  };
+  std::array<Control, MAX_CONTROLS> controls_;
+  std::vector<std::pair<std::string, uint16_t>> intervals_;
+  uint16_t default_interval_ = DEFAULT_INPUT_INTERVAL;
+  uint32_t events_received_ = 0;
+  uint32_t events_sent_ = 0;
+};
+
+} // namespace nspanel_lovelace
+} // namespace esphome
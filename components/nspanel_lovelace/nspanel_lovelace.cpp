@@ -1,6 +1,9 @@
 #include "nspanel_lovelace.h"
 
 #include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <stdio.h>
@@ -16,9 +19,9 @@
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/util.h"
-#include "esphome/components/json/json_util.h"
 
 #include "cards.h"
+#include "forecast.h"
 #include "card_items.h"
 #include "pages.h"
 #include "page_item_visitor.h"
@@ -28,34 +31,75 @@
 namespace esphome {
 namespace nspanel_lovelace {
 
-// Use PSRAM for ArduinoJson (if available, otherwise use normal malloc)
-// see: https://arduinojson.org/v6/how-to/use-external-ram-on-esp32/#how-to-use-the-psram-with-arduinojson
-struct SpiRamAllocator {
-  void* allocate(size_t size) {
-   if (psram_available())
-     return heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
-   else
-     return malloc(size);
-  }
-
-  void deallocate(void* pointer) {
-    if (psram_available())
-      heap_caps_free(pointer);
-    else
-      return free(pointer);
-  }
-
-  void* reallocate(void* ptr, size_t new_size) {
-    if (psram_available())
-      return heap_caps_realloc(ptr, new_size, MALLOC_CAP_SPIRAM);
-    else
-      return realloc(ptr, new_size);
-  }
-};
-using SpiRamJsonDocument = BasicJsonDocument<SpiRamAllocator>;
-
 static const char *const TAG = "nspanel_lovelace";
 
+// The Home Assistant attributes to subscribe to for each entity type
+// note: ha_attr_type::state is used for the state subscription
+static constexpr FrozenCharMap<entity_notify_mask_t, 23> ENTITY_SUBSCRIPTION_MAP =
+  make_frozen_map<entity_notify_mask_t, 23>({{
+  {entity_type::light, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::color_mode,
+    // need to subscribe to brightness to know if brightness is supported
+    ha_attr_type::brightness)},
+  {entity_type::switch_, entity_notify_attr(ha_attr_type::state)},
+  {entity_type::input_boolean, entity_notify_attr(ha_attr_type::state)},
+  {entity_type::input_text, entity_notify_attr(ha_attr_type::state)},
+  {entity_type::text, entity_notify_attr(ha_attr_type::state)},
+  {entity_type::automation, entity_notify_attr(ha_attr_type::state)},
+  {entity_type::sun, entity_notify_attr(ha_attr_type::state)},
+  {entity_type::vacuum, entity_notify_attr(ha_attr_type::state)},
+  {entity_type::lock, entity_notify_attr(ha_attr_type::state)},
+  {entity_type::person, entity_notify_attr(ha_attr_type::state)},
+  // icons and unit_of_measurement based on state and device_class
+  {entity_type::sensor, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::device_class, ha_attr_type::unit_of_measurement)},
+  {entity_type::binary_sensor, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::device_class, ha_attr_type::unit_of_measurement)},
+  {entity_type::cover, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::device_class, ha_attr_type::supported_features,
+    ha_attr_type::current_position, ha_attr_type::current_tilt_position)},
+  {entity_type::alarm_control_panel, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::code_arm_required, ha_attr_type::open_sensors)},
+  {entity_type::timer, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::editable, ha_attr_type::duration,
+    ha_attr_type::remaining, ha_attr_type::finishes_at)},
+  {entity_type::climate, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::temperature, ha_attr_type::current_temperature,
+    ha_attr_type::target_temp_high, ha_attr_type::target_temp_low,
+    ha_attr_type::target_temp_step, ha_attr_type::min_temp, ha_attr_type::max_temp,
+    ha_attr_type::hvac_action, ha_attr_type::preset_modes, ha_attr_type::swing_modes,
+    ha_attr_type::fan_modes, ha_attr_type::hvac_modes)},
+  {entity_type::media_player, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::supported_features, ha_attr_type::media_content_type,
+    ha_attr_type::media_title, ha_attr_type::media_artist,
+    ha_attr_type::volume_level, ha_attr_type::shuffle)},
+  {entity_type::select, entity_notify_attr(ha_attr_type::state, ha_attr_type::options)},
+  {entity_type::input_select, entity_notify_attr(ha_attr_type::state, ha_attr_type::options)},
+  {entity_type::number, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::min, ha_attr_type::max)},
+  {entity_type::input_number, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::min, ha_attr_type::max)},
+  {entity_type::fan, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::percentage_step, ha_attr_type::percentage,
+    ha_attr_type::preset_modes, ha_attr_type::preset_mode)},
+  {entity_type::weather, entity_notify_attr(ha_attr_type::state,
+    ha_attr_type::temperature, ha_attr_type::temperature_unit)},
+}});
+static_assert(is_frozen_map_sorted(ENTITY_SUBSCRIPTION_MAP), "ENTITY_SUBSCRIPTION_MAP must be built with make_frozen_map");
+
+// The attributes which are only rendered by popups, these are not stored in the
+// entity until its popup is first opened (see load_popup_attributes_)
+// note: color_temp is scaled using min/max_mireds so it must be loaded with them
+static constexpr FrozenCharMap<entity_notify_mask_t, 2> ENTITY_POPUP_SUBSCRIPTION_MAP =
+  make_frozen_map<entity_notify_mask_t, 2>({{
+  {entity_type::light, entity_notify_attr(
+    ha_attr_type::min_mireds, ha_attr_type::max_mireds,
+    ha_attr_type::supported_color_modes, ha_attr_type::color_temp,
+    ha_attr_type::effect_list)},
+  {entity_type::media_player, entity_notify_attr(ha_attr_type::source_list)},
+}});
+static_assert(is_frozen_map_sorted(ENTITY_POPUP_SUBSCRIPTION_MAP), "ENTITY_POPUP_SUBSCRIPTION_MAP must be built with make_frozen_map");
+
 NSPanelLovelace::NSPanelLovelace() {
   command_buffer_.reserve(1024);
 }
@@ -85,225 +129,10 @@ void NSPanelLovelace::setup() {
 #ifdef USE_TIME
   this->setup_time_();
 #endif
-  // todo: create entity for weather instead, so others can subscribe
-  if (!this->weather_entity_id_.empty()) {
-    // state provides the information for the icon
-    this->subscribe_homeassistant_state(
-        &NSPanelLovelace::on_weather_state_update_, this->weather_entity_id_);
-    this->subscribe_homeassistant_state(
-        &NSPanelLovelace::on_weather_temperature_update_,
-        this->weather_entity_id_, to_string(ha_attr_type::temperature));
-    this->subscribe_homeassistant_state(
-        &NSPanelLovelace::on_weather_temperature_unit_update_,
-        this->weather_entity_id_, to_string(ha_attr_type::temperature_unit));
-    this->subscribe_homeassistant_state(
-        &NSPanelLovelace::on_weather_forecast_update_, this->weather_entity_id_,
-        to_string(ha_attr_type::forecast));
-  }
-  
-  for (auto &entity : this->entities_) {
-    auto &entity_id = entity->get_entity_id();
-    ESP_LOGV(TAG, "Adding subscriptions for entity '%s'", entity_id.c_str());
-    bool add_state_subscription = false;
-    if (entity->is_type(entity_type::light)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::supported_color_modes));
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::color_mode));
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::min_mireds));
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::max_mireds));
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::color_temp));
-      // need to subscribe to brightness to know if brightness is supported
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::brightness));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::effect_list));
-    }
-    else if (entity->is_type(entity_type::switch_) ||
-        entity->is_type(entity_type::input_boolean) ||
-        entity->is_type(entity_type::input_text) ||
-        entity->is_type(entity_type::text) ||
-        entity->is_type(entity_type::automation) ||
-        entity->is_type(entity_type::sun) ||
-        entity->is_type(entity_type::vacuum) ||
-        entity->is_type(entity_type::lock) ||
-        entity->is_type(entity_type::person)) {
-      add_state_subscription = true;
-    }
-    // icons and unit_of_measurement based on state and device_class
-    else if (entity->is_type(entity_type::sensor) ||
-        entity->is_type(entity_type::binary_sensor)) {
-      add_state_subscription = true;
-      // if (!entity->is_icon_value_overridden()) {
-        this->subscribe_homeassistant_state_attr(
-            &NSPanelLovelace::on_entity_attribute_update_, 
-            entity_id, to_string(ha_attr_type::device_class));
-      // }
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::unit_of_measurement));
-    }
-    else if (entity->is_type(entity_type::cover)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::device_class));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::supported_features));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::current_position));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::current_tilt_position));
-    }
-    else if (entity->is_type(entity_type::alarm_control_panel)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::code_arm_required));
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::open_sensors));
-    }
-    else if (entity->is_type(entity_type::timer)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::editable));
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::duration));
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::remaining));
-      this->subscribe_homeassistant_state_attr(
-        &NSPanelLovelace::on_entity_attribute_update_,
-        entity_id, to_string(ha_attr_type::finishes_at));
-    }
-    else if (entity->is_type(entity_type::climate)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::temperature));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::current_temperature));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::target_temp_high));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::target_temp_low));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::target_temp_step));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::min_temp));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::max_temp));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::hvac_action));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::preset_modes));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::swing_modes));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::fan_modes));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::hvac_modes));
-    }
-    else if (entity->is_type(entity_type::media_player)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::supported_features));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::media_content_type));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::media_title));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::media_artist));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::volume_level));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::shuffle));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::source_list));
-    }
-    else if (entity->is_type(entity_type::select) ||
-        entity->is_type(entity_type::input_select)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::options));
-    }
-    else if (entity->is_type(entity_type::number) ||
-        entity->is_type(entity_type::input_number)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::min));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::max));
-    }
-    else if (entity->is_type(entity_type::weather)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::temperature));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::temperature_unit));
-    }
-    else if (entity->is_type(entity_type::fan)) {
-      add_state_subscription = true;
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::percentage_step));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::percentage));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::preset_modes));
-      this->subscribe_homeassistant_state_attr(
-          &NSPanelLovelace::on_entity_attribute_update_, 
-          entity_id, to_string(ha_attr_type::preset_mode));
-    }
-
-    if (add_state_subscription) {
-      this->subscribe_homeassistant_state(
-        &NSPanelLovelace::on_entity_state_update_,
-        entity_id);
-    }
+  if (this->screensaver_ != nullptr && this->weather_entity_ != nullptr) {
+    this->screensaver_->set_weather_entity(this->weather_entity_);
   }
+  this->setup_subscriptions_();
 
   this->set_timeout(1000, [this]() {
     // The display isn't reset when ESP is reset (on ota update etc.)
@@ -322,6 +151,140 @@ void NSPanelLovelace::setup() {
   });
 }
 
+void NSPanelLovelace::setup_subscriptions_() {
+  auto start_ms = millis();
+  auto start_heap = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+
+  // Build the list of (entity, attribute) pairs first so each pair is only subscribed once
+  std::vector<HaSubscription> subscriptions;
+  auto add_subscriptions = [&subscriptions](const std::string &entity_id,
+      Entity *entity, entity_notify_mask_t mask, bool forecast, bool deferred) {
+    for (uint8_t i = 0; i < 64; i++) {
+      if (!(mask & (1ULL << i))) continue;
+      auto attr = static_cast<ha_attr_type>(i);
+      auto it = std::find_if(subscriptions.begin(), subscriptions.end(),
+        [&entity_id, attr](const HaSubscription &sub) {
+          return sub.attr == attr && *sub.entity_id == entity_id;
+        });
+      if (it == subscriptions.end()) {
+        subscriptions.push_back({&entity_id, entity, attr, forecast, deferred});
+        continue;
+      }
+      if (entity != nullptr) it->entity = entity;
+      it->forecast |= forecast;
+      it->deferred &= deferred;
+    }
+  };
+
+  for (auto &entity : this->entities_) {
+    auto mask = find_value(ENTITY_SUBSCRIPTION_MAP, entity->get_type());
+    if (mask == nullptr) continue;
+    ESP_LOGV(TAG, "Adding subscriptions for entity '%s'", entity->get_entity_id().c_str());
+    add_subscriptions(entity->get_entity_id(), entity.get(), *mask, false, false);
+    // note: The API only sends the subscriptions to HA when it connects so the
+    //       popup attributes are also subscribed now, but held until required.
+    auto popup_mask = find_value(ENTITY_POPUP_SUBSCRIPTION_MAP, entity->get_type());
+    if (popup_mask == nullptr) continue;
+    add_subscriptions(entity->get_entity_id(), entity.get(), *popup_mask, false, true);
+  }
+  if (this->weather_entity_ != nullptr) {
+    // note: the weather entity can be a template sensor (see README)
+    //       so the attributes rendered by the screensaver are always added
+    auto &entity_id = this->weather_entity_->get_entity_id();
+    add_subscriptions(entity_id, this->weather_entity_.get(), entity_notify_attr(
+      ha_attr_type::state, ha_attr_type::temperature, ha_attr_type::temperature_unit),
+      false, false);
+    add_subscriptions(entity_id, nullptr,
+      entity_notify_attr(ha_attr_type::forecast), true, false);
+  }
+
+  // The callbacks only capture two pointers so std::function can store them
+  // without a heap allocation, the subscriptions must not move after this.
+  this->ha_subscriptions_ = std::move(subscriptions);
+  this->ha_subscriptions_.shrink_to_fit();
+  this->deferred_subscriptions_ = 0;
+  for (auto &sub : this->ha_subscriptions_) {
+    if (sub.deferred) this->deferred_subscriptions_++;
+    HaSubscription *sub_ptr = &sub;
+    api::global_api_server->subscribe_home_assistant_state(
+      *sub.entity_id,
+      optional<std::string>(sub.attr == ha_attr_type::state ? "" : to_string(sub.attr)),
+      [this, sub_ptr](std::string value) {
+        this->on_ha_subscription_update_(*sub_ptr, std::move(value));
+      });
+  }
+
+  ESP_LOGD(TAG, "Subscribed to %zu HA attributes in %" PRIu32 "ms (heap used: %d bytes)",
+    this->ha_subscriptions_.size(), millis() - start_ms,
+    static_cast<int>(start_heap - heap_caps_get_free_size(MALLOC_CAP_INTERNAL)));
+}
+
+void NSPanelLovelace::on_ha_subscription_update_(HaSubscription &sub, std::string value) {
+  if (this->ha_syncing_) {
+    this->ha_sync_last_update_ = millis();
+    this->ha_sync_updates_++;
+  }
+  if (sub.deferred) {
+    // identical values (e.g. the effect_list of identical bulbs) share one copy
+    sub.pending = PooledString(value);
+    return;
+  }
+  if (sub.forecast) {
+    this->on_weather_forecast_update_(
+      sub.entity == nullptr ? std::move(value) : std::string(value));
+  }
+  if (sub.entity != nullptr) {
+    this->on_entity_attribute_update_(sub.entity, sub.attr, std::move(value));
+  }
+}
+
+void NSPanelLovelace::load_popup_attributes_(Entity *entity) {
+  if (entity == nullptr || this->deferred_subscriptions_ == 0) return;
+  uint16_t count = 0;
+  // note: subscriptions are ordered by attribute so min/max_mireds are set before color_temp
+  for (auto &sub : this->ha_subscriptions_) {
+    if (!sub.deferred || sub.entity != entity) continue;
+    sub.deferred = false;
+    if (!sub.pending.empty()) {
+      entity->set_attribute(sub.attr, sub.pending.str());
+      sub.pending = PooledString();
+    }
+    count++;
+  }
+  if (count == 0) return;
+  this->deferred_subscriptions_ -= count;
+  ESP_LOGD(TAG, "Loaded %" PRIu16 " popup attributes for '%s'",
+    count, entity->get_entity_id().c_str());
+}
+
+void NSPanelLovelace::update_ha_sync_state_() {
+  bool connected = api::global_api_server != nullptr &&
+    api::global_api_server->is_connected();
+  if (connected != this->api_connected_) {
+    this->api_connected_ = connected;
+    if (connected) {
+      ESP_LOGD(TAG, "HA sync started");
+      this->ha_syncing_ = true;
+      this->ha_sync_start_ = this->ha_sync_last_update_ = millis();
+      this->ha_sync_updates_ = 0;
+    } else {
+      this->ha_syncing_ = false;
+    }
+    return;
+  }
+  if (!this->ha_syncing_) return;
+
+  auto now = millis();
+  if (now - this->ha_sync_last_update_ < HA_SYNC_QUIET_PERIOD &&
+      now - this->ha_sync_start_ < HA_SYNC_MAX_DURATION) {
+    return;
+  }
+  this->ha_syncing_ = false;
+  ESP_LOGD(TAG, "HA sync finished: %" PRIu16 " updates in %" PRIu32 "ms",
+    this->ha_sync_updates_, now - this->ha_sync_start_);
+  this->force_current_page_update_ = this->current_page_ != nullptr;
+}
+
 void NSPanelLovelace::loop() {
 #ifdef USE_NSPANEL_TFT_UPLOAD
   if (this->is_updating_ || this->reparse_mode_) {
@@ -340,6 +303,8 @@ void NSPanelLovelace::loop() {
     }
   }
 
+  this->update_ha_sync_state_();
+
   if (this->force_current_page_update_) {
     this->force_current_page_update_ = false;
     ESP_LOGD(TAG, "Render HA update");
@@ -387,9 +352,8 @@ void NSPanelLovelace::on_page_item_added_callback(const std::shared_ptr<PageItem
 }
 
 void NSPanelLovelace::set_display_timeout(uint16_t timeout) {
-  this->command_buffer_
-    .assign("timeout").append(1, SEPARATOR)
-    .append(esphome::to_string(timeout));
+  this->command_buffer_.assign("timeout").append(1, SEPARATOR);
+  append_number(this->command_buffer_, timeout);
   this->send_buffered_command_();
 }
 
@@ -421,14 +385,13 @@ void NSPanelLovelace::set_display_dim(uint8_t inactive, uint8_t active) {
 
   if (save_state) this->save_state_();
   
-  this->command_buffer_
-    .assign("dimmode").append(1, SEPARATOR)
-    // brightness when inactive (after timeout reached)
-    .append(esphome::to_string(this->display_inactive_dim_)).append(1, SEPARATOR)
-    // brightness when active (when buttons pressed)
-    .append(esphome::to_string(this->display_active_dim_)).append(1, SEPARATOR)
+  this->command_buffer_.assign("dimmode").append(1, SEPARATOR);
+  // brightness when inactive (after timeout reached)
+  append_number(this->command_buffer_, this->display_inactive_dim_).append(1, SEPARATOR);
+  // brightness when active (when buttons pressed)
+  append_number(this->command_buffer_, this->display_active_dim_).append(1, SEPARATOR)
     // background colour when active (not screensaver background, defaults to ha-dark)
-    .append(esphome::to_string(6371));
+    .append("6371");
   
   this->send_buffered_command_();
 }
@@ -599,6 +562,9 @@ void NSPanelLovelace::render_current_page_() {
   this->popup_page_current_uuid_.clear();
 
   this->set_display_timeout(this->current_page_->get_sleep_timeout());
+
+  if (this->current_page_ == this->screensaver_ && this->weather_forecast_invalid_)
+    this->update_weather_forecast_();
   
   this->render_item_update_(this->current_page_);
 }
@@ -631,7 +597,7 @@ void NSPanelLovelace::render_popup_notify_page_(const std::string &internal_id,
       .append(1, SEPARATOR).append("popupNotify");
   this->send_buffered_command_();
 
-  auto text_colour = std::to_string(65535U);
+  const char *text_colour = "65535";
   this->command_buffer_
     .assign("entityUpdateDetail").append(1, SEPARATOR)
     .append(internal_id).append(1, SEPARATOR)
@@ -646,15 +612,17 @@ void NSPanelLovelace::render_popup_notify_page_(const std::string &internal_id,
     .append(text_colour).append(1, SEPARATOR)
     // message
     .append(message).append(1, SEPARATOR)
-    .append(text_colour).append(1, SEPARATOR)
-    // timeout
-    .append(std::to_string(timeout));
+    .append(text_colour).append(1, SEPARATOR);
+  // timeout
+  append_number(this->command_buffer_, timeout);
 
   this->send_buffered_command_();
 }
 
 void NSPanelLovelace::render_popup_page_(const std::string &internal_id) {
   if (this->current_page_ == nullptr) return;
+  // the popup was (re)opened so the full detail must be sent
+  this->popup_detail_last_.clear();
   if (!this->render_popup_page_update_(internal_id)) return;
   this->set_display_timeout(10);
 }
@@ -709,19 +677,13 @@ bool NSPanelLovelace::render_popup_page_update_(const std::string &internal_id)
 
 bool NSPanelLovelace::render_popup_page_update_(StatefulPageItem *item) {
   if (item == nullptr) return false;
+  this->load_popup_attributes_(item->get_entity());
 
   if (item->is_type(entity_type::light)) {
     this->render_light_detail_update_(item);
   } else if (item->is_type(entity_type::timer)) {
     this->set_display_timeout(30);
     this->render_timer_detail_update_(item);
-    this->set_interval(entity_type::timer, 1000, [this, item]() {
-      if (this->popup_page_current_uuid_ != item->get_uuid()) {
-        this->cancel_interval(entity_type::timer);
-        return;
-      }
-      this->render_timer_detail_update_(item);
-    });
   } else if (item->is_type(entity_type::cover)) {
     this->render_cover_detail_update_(item);
   } else if (item->is_type(entity_type::climate)) {
@@ -737,6 +699,16 @@ bool NSPanelLovelace::render_popup_page_update_(StatefulPageItem *item) {
     return false;
   }
 
+  // HA sends intermediate states back while a control is being used, the fields
+  // the control owns show the input value so these updates are often identical
+  if (this->active_controls_.is_active(item->get_uuid(), millis()) &&
+      this->command_buffer_ == this->popup_detail_last_) {
+    ESP_LOGV(TAG, "Popup update suppressed: %s", item->get_uuid().c_str());
+    this->active_controls_.on_render_suppressed();
+    this->command_buffer_.clear();
+    return true;
+  }
+  this->popup_detail_last_ = this->command_buffer_;
   this->send_buffered_command_();
   return true;
 }
@@ -747,11 +719,8 @@ void NSPanelLovelace::render_cover_detail_update_(StatefulPageItem *item) {
 
   auto entity = item->get_entity();
 
-  std::array<const char *, 4> cover_icons{};
-  bool cover_icons_found = try_get_value(COVER_MAP,
-    cover_icons,
-    entity->get_attribute(ha_attr_type::device_class),
-    entity_cover_type::window);
+  auto cover_icons = item->get_cover_icons();
+  bool cover_icons_found = cover_icons != nullptr;
 
   auto &position_str = entity->
     get_attribute(ha_attr_type::current_position);
@@ -763,6 +732,16 @@ void NSPanelLovelace::render_cover_detail_update_(StatefulPageItem *item) {
   uint8_t position = value_or_default(position_str, 0U);
   uint8_t tilt_position = value_or_default(entity->
     get_attribute(ha_attr_type::current_tilt_position), 0U);
+  // the sliders being used show the input value, not the intermediate HA states
+  const uint32_t now = millis();
+  if (auto input = this->active_controls_.get_value(
+      item->get_uuid(), button_type::positionSlider, now)) {
+    position = value_or_default(*input, position);
+  }
+  if (auto input = this->active_controls_.get_value(
+      item->get_uuid(), button_type::tiltSlider, now)) {
+    tilt_position = value_or_default(*input, tilt_position);
+  }
   uint16_t supported_features = value_or_default(entity->
     get_attribute(ha_attr_type::supported_features), 0U);
 
@@ -790,15 +769,15 @@ void NSPanelLovelace::render_cover_detail_update_(StatefulPageItem *item) {
 
   if (cover_icons_found) {
     if (entity->is_state(entity_state::closed)) {
-      cover_icon = cover_icons.at(1);
+      cover_icon = cover_icons->at(1);
     } else {
-      cover_icon = cover_icons.at(0);
+      cover_icon = cover_icons->at(0);
     }
   }
 
   // Position
   if (supported_features & 0b00001111) {
-    text_position = get_translation(translation_item::position);
+    text_position = get_translation(static_translation::position);
     position_status = true;
   }
   // OPEN
@@ -809,7 +788,7 @@ void NSPanelLovelace::render_cover_detail_update_(StatefulPageItem *item) {
       icon_up_status = true;
     }
     if (cover_icons_found)
-      icon_up = cover_icons.at(2);
+      icon_up = cover_icons->at(2);
   }
   // CLOSE
   if (supported_features & 0b00000010) {
@@ -819,7 +798,7 @@ void NSPanelLovelace::render_cover_detail_update_(StatefulPageItem *item) {
       icon_down_status = true;
     }
     if (cover_icons_found)
-      icon_down = cover_icons.at(3);
+      icon_down = cover_icons->at(3);
   }
   // STOP
   if (supported_features & 0b00001000) {
@@ -829,7 +808,7 @@ void NSPanelLovelace::render_cover_detail_update_(StatefulPageItem *item) {
 
   // Tilt supported
   if (supported_features & 0b11110000) {
-    text_tilt = get_translation(translation_item::tilt_position);
+    text_tilt = get_translation(static_translation::tilt_position);
   }
   // SUPPORT_OPEN_TILT
   if (supported_features & 0b00010000) {
@@ -861,15 +840,17 @@ void NSPanelLovelace::render_cover_detail_update_(StatefulPageItem *item) {
     // entityUpdateDetail~
     .assign("entityUpdateDetail").append(1, SEPARATOR)
     // entity_id~
-    .append("uuid.").append(item->get_uuid()).append(1, SEPARATOR)
-    // slider_pos~
-    .append(esphome::to_string(position)).append(1, SEPARATOR)
+    .append("uuid.").append(item->get_uuid()).append(1, SEPARATOR);
+  // slider_pos~
+  append_number(this->command_buffer_, position).append(1, SEPARATOR)
     // position text + state / value~
-    .append(text_position).append(": ")
-    .append(position_status
-      ? esphome::to_string(position).append("%")
-      : entity->get_state())
-    .append(1, SEPARATOR)
+    .append(text_position).append(": ");
+  if (position_status) {
+    append_number(this->command_buffer_, position).append(1, '%');
+  } else {
+    this->command_buffer_.append(entity->get_state());
+  }
+  this->command_buffer_.append(1, SEPARATOR)
     // position text~
     .append(text_position).append(1, SEPARATOR)
     // icon~
@@ -908,10 +889,13 @@ void NSPanelLovelace::render_cover_detail_update_(StatefulPageItem *item) {
     // icon_tilt_right_status~
     .append(icon_tilt_right_status
       ? generic_type::enable : generic_type::disable)
-    .append(1, SEPARATOR)
-    // tilt_position_status
-    .append(tilt_position_status
-      ? std::to_string(tilt_position).append("%") : generic_type::disable);
+    .append(1, SEPARATOR);
+  // tilt_position_status
+  if (tilt_position_status) {
+    append_number(this->command_buffer_, tilt_position).append(1, '%');
+  } else {
+    this->command_buffer_.append(generic_type::disable);
+  }
 }
 
 // entityUpdateDetail~{entity_id}~~{icon_color}~{switch_val}~{brightness}~{color_temp}~{color}~{color_translation}~{color_temp_translation}~{brightness_translation}~{effect_supported}
@@ -927,10 +911,19 @@ void NSPanelLovelace::render_light_detail_update_(StatefulPageItem *item) {
       contains_value(supported_modes, ha_attr_color_mode::rgbw) ||
       contains_value(supported_modes, ha_attr_color_mode::rgbww));
 
+  // the sliders being used show the input value, not the intermediate HA states
+  const uint32_t now = millis();
+  auto brightness_input = this->active_controls_.get_value(
+    item->get_uuid(), button_type::brightnessSlider, now);
+  auto color_temp_input = this->active_controls_.get_value(
+    item->get_uuid(), button_type::colorTempSlider, now);
+
   std::string color_mode = entity->get_attribute(ha_attr_type::color_mode);
   std::string color_temp = generic_type::disable;
   if (contains_value(supported_modes, ha_attr_color_mode::color_temp)) {
-    if (color_mode == ha_attr_color_mode::color_temp) {
+    if (color_temp_input != nullptr) {
+      color_temp = *color_temp_input;
+    } else if (color_mode == ha_attr_color_mode::color_temp) {
       color_temp = entity->get_attribute(ha_attr_type::color_temp, generic_type::disable);
     } else {
       color_temp = entity_state::unknown;
@@ -943,39 +936,42 @@ void NSPanelLovelace::render_light_detail_update_(StatefulPageItem *item) {
     // entityUpdateDetail~
     .assign("entityUpdateDetail").append(1, SEPARATOR)
     // entity_id~~
-    .append("uuid.").append(item->get_uuid()).append(2, SEPARATOR)
-    // icon_color~
-    .append(item->get_icon_color_str()).append(1, SEPARATOR)
+    .append("uuid.").append(item->get_uuid()).append(2, SEPARATOR);
+  // icon_color~
+  append_number(this->command_buffer_, item->get_icon_color()).append(1, SEPARATOR)
     // switch_val~
-    .append(std::to_string(entity->is_state(entity_state::on) ? 1 : 0)).append(1, SEPARATOR)
+    .append(1, entity->is_state(entity_state::on) ? '1' : '0').append(1, SEPARATOR)
     // brightness~ (0-100)
-    .append(entity->get_attribute(ha_attr_type::brightness, generic_type::disable)).append(1, SEPARATOR)
+    .append(brightness_input != nullptr
+      ? *brightness_input
+      : entity->get_attribute(ha_attr_type::brightness, generic_type::disable))
+    .append(1, SEPARATOR)
     // color_temp~ (color temperature value or 'disable')
     .append(color_temp).append(1, SEPARATOR)
     // color~ ('enable' or 'disable')
     .append(enable_color_wheel ? generic_type::enable : generic_type::disable).append(1, SEPARATOR)
     // color_translation~
-    .append(get_translation(translation_item::color)).append(1, SEPARATOR)
+    .append(get_translation(static_translation::color)).append(1, SEPARATOR)
     // color_temp_translation~
-    .append(get_translation(translation_item::color_temp)).append(1, SEPARATOR)
+    .append(get_translation(static_translation::color_temp)).append(1, SEPARATOR)
     // brightness_translation~
-    .append(get_translation(translation_item::brightness)).append(1, SEPARATOR)
+    .append(get_translation(static_translation::brightness)).append(1, SEPARATOR)
     // effect_supported ('enable' or 'disable')
     .append(entity->has_attribute(ha_attr_type::effect_list) ?
       generic_type::enable : generic_type::disable);
 }
 
-// entityUpdateDetail~{entity_id}~~{icon_color}~{entity_id}~{min_remaining}~{sec_remaining}~{editable}~{action1}~{action2}~{action3}~{label1}~{label2}~{label3}
 void NSPanelLovelace::render_timer_detail_update_(StatefulPageItem *item) {
   if (item == nullptr) return;
 
+  auto &cache = this->timer_detail_;
   auto &state = item->get_state();
   bool render = false;
   uint16_t min_remaining = 0, sec_remaining = 0;
   bool idle = state == entity_state::paused || state == entity_state::idle;
+  cache.finishes_at = 0;
 
   if (idle) {
-    this->cancel_interval(entity_type::timer);
     std::string time_remaining_str;
     if (state == entity_state::paused) {
       time_remaining_str = item->get_attribute(ha_attr_type::remaining);
@@ -985,54 +981,49 @@ void NSPanelLovelace::render_timer_detail_update_(StatefulPageItem *item) {
     if (!time_remaining_str.empty()) {
       std::vector<std::string> time_parts;
       split_str(':', time_remaining_str, time_parts);
-      if (time_parts.size() == 3) {
-        min_remaining = (stoi(time_parts[0]) * 60) + stoi(time_parts[1]);
-        sec_remaining = stoi(time_parts[2]);
+      uint32_t hours, minutes, seconds;
+      if (time_parts.size() == 3 &&
+          parse_uint(time_parts[0], hours) &&
+          parse_uint(time_parts[1], minutes) &&
+          parse_uint(time_parts[2], seconds)) {
+        min_remaining = (hours * 60) + minutes;
+        sec_remaining = seconds;
         render = true;
       }
     }
   }
   // active
   else {
-    auto &finishes_at = item->get_attribute(ha_attr_type::finishes_at);
-    if (!finishes_at.empty()) {
-      tm t{};
-      if (iso8601_to_tm(finishes_at.c_str(), t)) {
-        ESPTime now = this->time_id_.value()->now();
-        if (now.is_valid()) {
-          double seconds = difftime(mktime(&t), now.timestamp);
-          if (seconds >= UINT16_MAX) seconds = UINT16_MAX;
-          if (seconds < 0) seconds = 0;
-          min_remaining = static_cast<uint16_t>(seconds) / 60;
-          sec_remaining = static_cast<uint16_t>(seconds) % 60;
-          render = true;
-          if (seconds == 0) {
-            this->cancel_interval(entity_type::timer);
-          }
-        }
-      }
+    // note: the epoch is parsed once when finishes_at is received
+    cache.finishes_at = item->get_entity()->get_attribute_epoch(ha_attr_type::finishes_at);
+    uint32_t seconds = 0;
+    if (this->get_timer_seconds_remaining_(seconds)) {
+      min_remaining = seconds / 60;
+      sec_remaining = seconds % 60;
+      render = true;
     }
   }
 
+  // only tick while the timer is active
+  this->set_timer_detail_tick_(render && !idle ? item : nullptr);
   if (!render) {
     this->render_current_page_();
     return;
   }
 
-  this->command_buffer_
+  // The parts of the command which only change when the entity is updated
+  cache.prefix
     // entityUpdateDetail~
     .assign("entityUpdateDetail").append(1, SEPARATOR)
     // entity_id~~
-    .append("uuid.").append(item->get_uuid()).append(2, SEPARATOR)
-    // icon_color~
-    .append(item->get_icon_color_str()).append(1, SEPARATOR)
+    .append("uuid.").append(item->get_uuid()).append(2, SEPARATOR);
+  // icon_color~
+  append_number(cache.prefix, item->get_icon_color()).append(1, SEPARATOR)
     // entity_id~~
-    .append("uuid.").append(item->get_uuid()).append(1, SEPARATOR)
-    // min_remaining~
-    .append(std::to_string(min_remaining)).append(1, SEPARATOR)
-    // sec_remaining~
-    .append(std::to_string(sec_remaining)).append(1, SEPARATOR)
-    // editable~
+    .append("uuid.").append(item->get_uuid()).append(1, SEPARATOR);
+  cache.suffix
+    // ~editable~
+    .assign(1, SEPARATOR)
     .append((idle && 
       item->get_attribute(ha_attr_type::editable) == entity_state::on)
         ? "1" : "0")
@@ -1046,14 +1037,72 @@ void NSPanelLovelace::render_timer_detail_update_(StatefulPageItem *item) {
     .append(idle ? "" : ha_action_type::finish)
     .append(1, SEPARATOR)
     // label1~
-    .append(idle ? "" : get_translation(translation_item::pause_))
+    .append(idle ? "" : get_translation(static_translation::pause))
     .append(1, SEPARATOR)
     // label2~
     .append(get_translation(idle ? 
-      translation_item::start : translation_item::cancel))
+      static_translation::start : static_translation::cancel))
     .append(1, SEPARATOR)
     // label3
-    .append(idle ? "" : get_translation(translation_item::finish));
+    .append(idle ? "" : get_translation(static_translation::finish));
+
+  cache.seconds_displayed = min_remaining * 60U + sec_remaining;
+  this->render_timer_detail_remaining_(min_remaining, sec_remaining);
+}
+
+// Called every second while an active timer popup is open
+void NSPanelLovelace::render_timer_detail_tick_() {
+  auto &cache = this->timer_detail_;
+  uint32_t seconds = 0;
+  if (cache.finishes_at == 0 || !this->get_timer_seconds_remaining_(seconds)) {
+    this->set_timer_detail_tick_(nullptr);
+    return;
+  }
+  if (seconds == 0) this->set_timer_detail_tick_(nullptr);
+  // only send a frame when the displayed value changes
+  if (seconds == cache.seconds_displayed) return;
+  cache.seconds_displayed = seconds;
+  this->render_timer_detail_remaining_(seconds / 60, seconds % 60);
+  this->send_buffered_command_();
+}
+
+// Starts (or stops when nullptr) the 1s updates of the timer popup, the interval
+// is only re-armed when the item changes so entity updates don't restart it
+void NSPanelLovelace::set_timer_detail_tick_(StatefulPageItem *item) {
+  auto &cache = this->timer_detail_;
+  if (cache.ticking_item == item) return;
+  cache.ticking_item = item;
+  if (item == nullptr) {
+    this->cancel_interval(entity_type::timer);
+    return;
+  }
+  this->set_interval(entity_type::timer, 1000, [this, item]() {
+    if (this->popup_page_current_uuid_ != item->get_uuid()) {
+      this->set_timer_detail_tick_(nullptr);
+      return;
+    }
+    this->render_timer_detail_tick_();
+  });
+}
+
+bool NSPanelLovelace::get_timer_seconds_remaining_(uint32_t &seconds) {
+  if (this->timer_detail_.finishes_at == 0 || !this->time_id_.has_value())
+    return false;
+  ESPTime now = this->time_id_.value()->now();
+  if (!now.is_valid()) return false;
+  auto remaining = this->timer_detail_.finishes_at - now.timestamp;
+  seconds = remaining <= 0 ? 0 : std::min<time_t>(remaining, UINT16_MAX);
+  return true;
+}
+
+// entityUpdateDetail~{entity_id}~~{icon_color}~{entity_id}~{min_remaining}~{sec_remaining}~{editable}~{action1}~{action2}~{action3}~{label1}~{label2}~{label3}
+void NSPanelLovelace::render_timer_detail_remaining_(uint16_t minutes, uint16_t seconds) {
+  this->command_buffer_.assign(this->timer_detail_.prefix);
+  // min_remaining~
+  append_number(this->command_buffer_, minutes).append(1, SEPARATOR);
+  // sec_remaining
+  append_number(this->command_buffer_, seconds)
+    .append(this->timer_detail_.suffix);
 }
 
 void NSPanelLovelace::render_climate_detail_update_(StatefulPageItem *item) {
@@ -1092,9 +1141,9 @@ void NSPanelLovelace::render_climate_detail_update_(Entity *entity, const std::s
   this->command_buffer_.append(1, SEPARATOR)
     // icon_id~
     .append(get_icon(CLIMATE_ICON_MAP, entity->get_state()))
-    .append(1, SEPARATOR)
-    // icon_color~
-    .append(std::to_string(icon_colour)).append(1, SEPARATOR);
+    .append(1, SEPARATOR);
+  // icon_color~
+  append_number(this->command_buffer_, icon_colour).append(1, SEPARATOR);
 
   std::vector<ha_attr_type> mode_types = {
     ha_attr_type::preset_modes,
@@ -1160,9 +1209,9 @@ void NSPanelLovelace::render_input_select_detail_update_(StatefulPageItem *item)
     // entityUpdateDetail2~
     .assign("entityUpdateDetail2").append(1, SEPARATOR)
     // entity_id~~
-    .append("uuid.").append(item->get_uuid()).append(2, SEPARATOR)
-    // icon_color~
-    .append(item->get_icon_color_str()).append(1, SEPARATOR)
+    .append("uuid.").append(item->get_uuid()).append(2, SEPARATOR);
+  // icon_color~
+  append_number(this->command_buffer_, item->get_icon_color()).append(1, SEPARATOR)
     // ha_type~
     .append(item->get_type()).append(1, SEPARATOR)
     // state~
@@ -1183,36 +1232,36 @@ void NSPanelLovelace::render_fan_detail_update_(StatefulPageItem *item) {
 
   uint8_t speed_max = 100;
   if (!percentage_step.empty()) {
-    float speed_val = 0.0f;
-    if (speed.empty()) {
-      speed = "0";
-    } else {
-      speed_val = std::stof(speed);
-    }
-    auto step_val = std::stof(percentage_step);
+    float speed_val = value_or_default(speed, 0.0f);
+    auto step_val = value_or_default(percentage_step, 1.0f);
     if (step_val < 1.0f) step_val = 1.0f; // avoid divide-by-zero
-    speed = esphome::to_string(
-      static_cast<uint16_t>(round(speed_val / step_val)));
+    speed.clear();
+    append_number(speed, static_cast<uint16_t>(round(speed_val / step_val)));
     speed_max = static_cast<uint16_t>(round(100.0f / step_val));
+    // the slider being used shows the input value, not the intermediate HA states
+    if (auto input = this->active_controls_.get_value(
+        item->get_uuid(), button_type::numberSet, millis())) {
+      speed = *input;
+    }
   }
 
   this->command_buffer_
     // entityUpdateDetail~
     .assign("entityUpdateDetail").append(1, SEPARATOR)
     // entity_id~~
-    .append("uuid.").append(item->get_uuid()).append(2, SEPARATOR)
-    // icon_color~
-    .append(item->get_icon_color_str()).append(1, SEPARATOR)
+    .append("uuid.").append(item->get_uuid()).append(2, SEPARATOR);
+  // icon_color~
+  append_number(this->command_buffer_, item->get_icon_color()).append(1, SEPARATOR)
     // switch_val~
-    .append(esphome::to_string(item->is_state(entity_state::on) ? 1 : 0))
+    .append(1, item->is_state(entity_state::on) ? '1' : '0')
     .append(1, SEPARATOR)
     // speed~
     .append(percentage_step.empty() ? generic_type::disable : speed)
-    .append(1, SEPARATOR)
-    // speed_max~
-    .append(esphome::to_string(speed_max)).append(1, SEPARATOR)
+    .append(1, SEPARATOR);
+  // speed_max~
+  append_number(this->command_buffer_, speed_max).append(1, SEPARATOR)
     // speed_translation~
-    .append(get_translation(translation_item::speed)).append(1, SEPARATOR)
+    .append(get_translation(static_translation::speed)).append(1, SEPARATOR)
     // preset_mode~
     .append(preset_mode).append(1, SEPARATOR)
     // preset_modes
@@ -1232,6 +1281,29 @@ void NSPanelLovelace::dump_config() {
       this->pages_.size(),
       this->stateful_page_items_.size(),
       this->entities_.size());
+  uint32_t notifications_sent = 0, notifications_skipped = 0;
+  for (auto &entity : this->entities_) {
+    notifications_sent += entity->get_notifications_sent();
+    notifications_skipped += entity->get_notifications_skipped();
+  }
+  ESP_LOGCONFIG(TAG, "\tEntity notifications: sent:%" PRIu32 " skipped:%" PRIu32,
+      notifications_sent, notifications_skipped);
+  ESP_LOGCONFIG(TAG, "\tInput events: received:%" PRIu32 " sent:%" PRIu32,
+      this->input_coalescer_.get_events_received(),
+      this->input_coalescer_.get_events_sent());
+  ESP_LOGCONFIG(TAG, "\tOptimistic updates: confirmed:%" PRIu32 " rolled_back:%" PRIu32,
+      this->optimistic_state_.get_confirmed(),
+      this->optimistic_state_.get_rolled_back());
+  ESP_LOGCONFIG(TAG, "\tPopup updates suppressed: %" PRIu32,
+      this->active_controls_.get_renders_suppressed());
+  ESP_LOGCONFIG(TAG, "\tService calls: submitted:%" PRIu32 " sent:%" PRIu32,
+      this->service_call_queue_.get_calls_submitted(),
+      this->service_call_queue_.get_calls_sent());
+  ESP_LOGCONFIG(TAG, "\tString pool: entries:%zu refs:%zu bytes_used:%zu bytes_saved:%zu",
+      StringPool::get_size(),
+      StringPool::get_ref_count(),
+      StringPool::get_bytes_used(),
+      StringPool::get_bytes_saved());
 }
 
 void NSPanelLovelace::send_nextion_command_(const std::string &command) {
@@ -1402,7 +1474,7 @@ void NSPanelLovelace::init_display_(int baud_rate) {
 #ifdef USE_TIME
 // see: https://esphome.io/components/time/#strftime
 // note: Because ESP-IDF doesn't support locale (due to memory constraints),
-//       the only way to translate the time is to manually replace the date/time strings
+//       the day and month names are translated by DateTimeFormat
 void NSPanelLovelace::update_datetime(const datetime_mode mode, const char *date_format, const char *time_format) {
   ESPTime now = this->time_id_.value()->now();
 
@@ -1414,164 +1486,24 @@ void NSPanelLovelace::update_datetime(const datetime_mode mode, const char *date
   // ESP_LOGV(TAG, "datetime update %u,%u %u,%u", now.hour, this->now_hour_, now.minute, this->now_minute_);
   this->now_hour_ = now.hour;
   this->now_minute_ = now.minute;
+  const struct tm time = now.to_c_tm();
 
   if ((mode & datetime_mode::date) == datetime_mode::date) {
-    std::string datefmt(date_format);
-    // todo: fetch from config before using default value
-    if (datefmt.empty())
-      datefmt = this->date_format_;
-    auto timestr = now.strftime(datefmt);
-
-    if (this->language_ == "en" || this->language_ == "en-GB") {
-      goto skip_date_translate;
-    }
-
-    if (datefmt.find("%a", 0) != std::string::npos ||
-        datefmt.find("%A", 0) != std::string::npos || 
-        datefmt.find("%c", 0) != std::string::npos) {
-      switch(now.day_of_week) {
-        case 1:
-          replace_first(timestr, "Sunday",
-            get_translation(translation_item::dow_sunday));
-          replace_first(timestr, "Sun",
-            get_translation(translation_item::dow_sun));
-          break;
-        case 2:
-          replace_first(timestr, "Monday",
-            get_translation(translation_item::dow_monday));
-          replace_first(timestr, "Mon",
-            get_translation(translation_item::dow_mon));
-          break;
-        case 3:
-          replace_first(timestr, "Tuesday",
-            get_translation(translation_item::dow_tuesday));
-          replace_first(timestr, "Tue",
-            get_translation(translation_item::dow_tue));
-          break;
-        case 4:
-          replace_first(timestr, "Wednesday",
-            get_translation(translation_item::dow_wednesday));
-          replace_first(timestr, "Wed",
-            get_translation(translation_item::dow_wed));
-          break;
-        case 5:
-          replace_first(timestr, "Thursday",
-            get_translation(translation_item::dow_thursday));
-          replace_first(timestr, "Thu",
-            get_translation(translation_item::dow_thu));
-          break;
-        case 6:
-          replace_first(timestr, "Friday",
-            get_translation(translation_item::dow_friday));
-          replace_first(timestr, "Fri",
-            get_translation(translation_item::dow_fri));
-          break;
-        case 7:
-          replace_first(timestr, "Saturday",
-            get_translation(translation_item::dow_saturday));
-          replace_first(timestr, "Sat",
-            get_translation(translation_item::dow_sat));
-          break;
-        default:
-          break;
-      }
-    }
-
-    if (datefmt.find("%b", 0) != std::string::npos || 
-        datefmt.find("%B", 0) != std::string::npos ||
-        datefmt.find("%c", 0) != std::string::npos ||
-        datefmt.find("%h", 0) != std::string::npos) {
-      switch(now.month) {
-        case 1:
-          replace_first(timestr, "January",
-            get_translation(translation_item::month_january));
-          replace_first(timestr, "Jan",
-            get_translation(translation_item::month_jan));
-          break;
-        case 2:
-          replace_first(timestr, "February",
-            get_translation(translation_item::month_february));
-          replace_first(timestr, "Feb",
-            get_translation(translation_item::month_feb));
-          break;
-        case 3:
-          replace_first(timestr, "March",
-            get_translation(translation_item::month_march));
-          replace_first(timestr, "Mar",
-            get_translation(translation_item::month_mar));
-          break;
-        case 4:
-          replace_first(timestr, "April",
-            get_translation(translation_item::month_april));
-          replace_first(timestr, "Apr",
-            get_translation(translation_item::month_apr));
-          break;
-        case 5:
-          replace_first(timestr, "May",
-            get_translation(translation_item::month_may));
-          break;
-        case 6:
-          replace_first(timestr, "June",
-            get_translation(translation_item::month_june));
-          replace_first(timestr, "Jun",
-            get_translation(translation_item::month_jun));
-          break;
-        case 7:
-          replace_first(timestr, "July",
-            get_translation(translation_item::month_july));
-          replace_first(timestr, "Jul",
-            get_translation(translation_item::month_jul));
-          break;
-        case 8:
-          replace_first(timestr, "August",
-            get_translation(translation_item::month_august));
-          replace_first(timestr, "Aug",
-            get_translation(translation_item::month_aug));
-          break;
-        case 9:
-          replace_first(timestr, "September",
-            get_translation(translation_item::month_september));
-          replace_first(timestr, "Sep",
-            get_translation(translation_item::month_sep));
-          break;
-        case 10:
-          replace_first(timestr, "October",
-            get_translation(translation_item::month_october));
-          replace_first(timestr, "Oct",
-            get_translation(translation_item::month_oct));
-          break;
-        case 11:
-          replace_first(timestr, "November",
-            get_translation(translation_item::month_november));
-          replace_first(timestr, "Nov",
-            get_translation(translation_item::month_nov));
-          break;
-        case 12:
-          replace_first(timestr, "December",
-            get_translation(translation_item::month_december));
-          replace_first(timestr, "Dec",
-            get_translation(translation_item::month_dec));
-          break;
-        default:
-          break;
-      }
-    }
-  skip_date_translate:
-    this->command_buffer_
-      .assign("date").append(1, SEPARATOR)
-      .append(timestr);
+    this->command_buffer_.assign("date").append(1, SEPARATOR);
+    // note: formats passed in (e.g. from automations) are compiled on each call
+    if (date_format[0] == '\0')
+      this->date_format_.format(time, this->command_buffer_);
+    else
+      DateTimeFormat(date_format).format(time, this->command_buffer_);
     this->send_buffered_command_();
   }
 
   if ((mode & datetime_mode::time) == datetime_mode::time) {
-    std::string timefmt(time_format);
-    // todo: fetch from config before using default value
-    if (timefmt.empty())
-      timefmt = this->time_format_;
-    
-    this->command_buffer_
-      .assign("time").append(1, SEPARATOR)
-      .append(now.strftime(timefmt));
+    this->command_buffer_.assign("time").append(1, SEPARATOR);
+    if (time_format[0] == '\0')
+      this->time_format_.format(time, this->command_buffer_);
+    else
+      DateTimeFormat(time_format).format(time, this->command_buffer_);
     this->send_buffered_command_();
   }
 }
@@ -1580,11 +1512,10 @@ void NSPanelLovelace::setup_time_() {
   if (this->time_id_.has_value()) {
     this->time_id_.value()->add_on_time_sync_callback([this] {
       this->update_datetime(datetime_mode::both);
-    });
-    // Configure a callback to check the time every 1 second
-    this->set_interval("check_time", 1000, [this] {
+      // (re)schedules the minute updates
       this->check_time_();
     });
+    this->check_time_();
     this->time_configured_ = true;
   } else {
     ESP_LOGW(TAG, "time_id not configured, default time displayed");
@@ -1592,12 +1523,15 @@ void NSPanelLovelace::setup_time_() {
 }
 
 void NSPanelLovelace::check_time_() {
-  if (!this->time_id_.has_value() ||
-      !this->time_id_.value()->now().is_valid())
+  if (!this->time_id_.has_value())
     return;
 
   // todo: only check if the current page is screensaver?
   ESPTime now = this->time_id_.value()->now();
+  // note: the checks resume from the time sync callback
+  if (!now.is_valid())
+    return;
+
   // update the date once an hour to account for daylight saving etc.
   if (now.hour != this->now_hour_) {
     this->update_datetime(datetime_mode::both);
@@ -1606,6 +1540,14 @@ void NSPanelLovelace::check_time_() {
   else if (now.minute != this->now_minute_) {
     this->update_datetime(datetime_mode::time);
   }
+
+  // Wake up just after the minute changes instead of polling every second.
+  // If the timeout fires early the minute is unchanged and the next check is
+  // scheduled for shortly afterwards.
+  const uint32_t delay = (now.second < 60 ? 60 - now.second : 1) * 1000 + 50;
+  this->set_timeout("check_time", delay, [this] {
+    this->check_time_();
+  });
 }
 
 #endif
@@ -1634,36 +1576,86 @@ const std::string &NSPanelLovelace::try_replace_uuid_with_entity_id_(
   return item->get_entity_id();
 }
 
+void NSPanelLovelace::flush_input_() {
+  const uint32_t now = millis();
+  auto delay = this->input_coalescer_.flush(now,
+    [this](const std::string &id, const std::string &button_type, const std::string &value) {
+      ESP_LOGD(TAG, "Button press delayed: %s,%s,%s",
+          id.c_str(), button_type.c_str(), value.c_str());
+      // note: process_button_press_ replaces the uuid with the entity id
+      std::string internal_id(id);
+      this->process_button_press_(internal_id, button_type, value, true);
+    });
+  if (delay == 0) {
+    if (this->input_flush_at_ != 0) this->cancel_timeout("btnpr");
+    this->input_flush_at_ = 0;
+    return;
+  }
+  // only reschedule when the next interval to end has changed
+  if (this->input_flush_at_ == now + delay) return;
+  this->input_flush_at_ = now + delay;
+  this->set_timeout("btnpr", delay, [this]() {
+    this->input_flush_at_ = 0;
+    this->flush_input_();
+  });
+}
+
+void NSPanelLovelace::apply_optimistic_update_(
+    Entity *entity, ha_attr_type attr, const std::string &value) {
+  if (entity == nullptr) return;
+  ESP_LOGV(TAG, "Optimistic update: %s %s='%s'",
+    entity->get_entity_id().c_str(), to_string(attr), value.c_str());
+  this->optimistic_state_.apply(entity, attr, value, millis());
+  // the entity belongs to the page (or popup) the input came from
+  this->force_current_page_update_ = this->current_page_ != nullptr;
+  this->expire_optimistic_updates_();
+}
+
+void NSPanelLovelace::apply_optimistic_on_off_(Entity *entity, bool on) {
+  if (entity == nullptr ||
+      !(entity->is_state(entity_state::on) || entity->is_state(entity_state::off))) {
+    return;
+  }
+  this->apply_optimistic_update_(entity, ha_attr_type::state,
+    on ? entity_state::on : entity_state::off);
+}
+
+void NSPanelLovelace::expire_optimistic_updates_() {
+  const uint32_t now = millis();
+  auto delay = this->optimistic_state_.expire(now, [this](Entity *entity) {
+    ESP_LOGD(TAG, "Optimistic update rolled back: %s", entity->get_entity_id().c_str());
+    this->schedule_entity_render_(entity);
+  });
+  if (delay == 0) {
+    if (this->optimistic_expire_at_ != 0) this->cancel_timeout("optimistic");
+    this->optimistic_expire_at_ = 0;
+    return;
+  }
+  if (this->optimistic_expire_at_ == now + delay) return;
+  this->optimistic_expire_at_ = now + delay;
+  this->set_timeout("optimistic", delay, [this]() {
+    this->optimistic_expire_at_ = 0;
+    this->expire_optimistic_updates_();
+  });
+}
+
 void NSPanelLovelace::process_button_press_(
     std::string &internal_id, 
     const std::string &button_type, 
     const std::string &value,
-    bool called_from_timeout) {
+    bool coalesced) {
   if (button_type.empty()) return;
   
   // Throttle and filter processing of spammy actions to avoid command flooding
-  if (!called_from_timeout) {
-    if (internal_id == this->button_press_uuid_ && 
-        button_type == this->button_press_type_) {
-      this->button_press_value_ = value;
-      if (this->button_press_timeout_set_) return;
-      this->set_timeout("btnpr", 200, [this]() {
-        this->button_press_timeout_set_ = false;
-        ESP_LOGD(TAG, "Button press delayed: %s,%s,%s", 
-            this->button_press_uuid_.c_str(), this->button_press_type_.c_str(), 
-            this->button_press_value_.c_str());
-        this->process_button_press_(
-            this->button_press_uuid_, this->button_press_type_, 
-            this->button_press_value_, true);
-      });
-      this->button_press_timeout_set_ = true;
-      return;
-    } else if (this->button_press_timeout_set_) {
-      this->cancel_timeout("btnpr");
-      this->button_press_timeout_set_ = false;
+  if (!coalesced) {
+    if (!value.empty() && esphome::str_startswith(internal_id, entity_type::uuid)) {
+      this->active_controls_.on_input(
+        internal_id.substr(5), button_type, value, millis());
     }
-    this->button_press_uuid_ = internal_id;
-    this->button_press_type_ = button_type;
+    const bool process = this->input_coalescer_.on_event(
+      internal_id, button_type, value, millis());
+    this->flush_input_();
+    if (!process) return;
   }
 
   auto entity_type = get_entity_type(internal_id);
@@ -1713,6 +1705,7 @@ void NSPanelLovelace::process_button_press_(
         entity_type, 
         value == "1" ? ha_action_type::turn_on : ha_action_type::turn_off, 
         entity_id);
+      this->apply_optimistic_on_off_(this->get_entity_(entity_id), value == "1");
     }
   } 
   // fan, number, input_number
@@ -1720,28 +1713,24 @@ void NSPanelLovelace::process_button_press_(
     if (entity_type == entity_type::fan) {
       auto entity = this->get_entity_(entity_id);
       if (entity == nullptr) return;
-      auto step = std::stof(
-        entity->get_attribute(ha_attr_type::percentage_step, "0"));
+      float val;
+      if (!parse_float(value, val)) return;
+      auto step = value_or_default(
+        entity->get_attribute(ha_attr_type::percentage_step), 0.0f);
       if (step > 100.0f) step = 100.0f;
-      auto val = std::stof(value) * step;
+      val *= step;
       if (val > 100.0f) val = 100.0f;
       auto pct = esphome::str_snprintf("%.6f", 11, val);
       
       this->call_ha_service_(
-        entity_type, 
-        ha_action_type::set_percentage, 
-        {{
-          {to_string(ha_attr_type::entity_id), entity_id},
-          {to_string(ha_attr_type::percentage), pct}
-        }});
+        ServiceCall(entity_type, ha_action_type::set_percentage, entity_id)
+          .coalesce()
+          .add(ha_attr_type::percentage, pct));
     } else {
       this->call_ha_service_(
-        entity_type, 
-        ha_action_type::set_value, 
-        {{
-          {to_string(ha_attr_type::entity_id), entity_id},
-          {to_string(ha_attr_type::value), value}
-        }});
+        ServiceCall(entity_type, ha_action_type::set_value, entity_id)
+          .coalesce()
+          .add(ha_attr_type::value, value));
     }
   }
   // cover and shutter cards
@@ -1756,12 +1745,11 @@ void NSPanelLovelace::process_button_press_(
       entity_type, ha_action_type::close_cover, entity_id);
   } else if (button_type == button_type::positionSlider) {
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::set_cover_position, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::position), value}
-      }});
+      ServiceCall(entity_type, ha_action_type::set_cover_position, entity_id)
+        .coalesce()
+        .add(ha_attr_type::position, value));
+    this->apply_optimistic_update_(this->get_entity_(entity_id),
+      ha_attr_type::current_position, value);
   } else if (button_type == button_type::tiltOpen) {
     this->call_ha_service_(
       entity_type, ha_action_type::open_cover_tilt, entity_id);
@@ -1773,12 +1761,11 @@ void NSPanelLovelace::process_button_press_(
       entity_type, ha_action_type::close_cover_tilt, entity_id);
   } else if (button_type == button_type::tiltSlider) {
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::set_cover_tilt_position, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::tilt_position), value}
-      }});
+      ServiceCall(entity_type, ha_action_type::set_cover_tilt_position, entity_id)
+        .coalesce()
+        .add(ha_attr_type::tilt_position, value));
+    this->apply_optimistic_update_(this->get_entity_(entity_id),
+      ha_attr_type::current_tilt_position, value);
   } else if (button_type == button_type::button) {
     if (entity_type == entity_type::navigate ||
         entity_type == entity_type::navigate_uuid) {
@@ -1797,6 +1784,9 @@ void NSPanelLovelace::process_button_press_(
         entity_type == entity_type::fan) {
       this->call_ha_service_(
         entity_type, ha_action_type::toggle, entity_id);
+      auto entity = this->get_entity_(entity_id);
+      if (entity != nullptr)
+        this->apply_optimistic_on_off_(entity, !entity->is_state(entity_state::on));
     } else if (
         entity_type == entity_type::button ||
         entity_type == entity_type::input_button) {
@@ -1850,188 +1840,167 @@ void NSPanelLovelace::process_button_press_(
     shuffle = shuffle == entity_state::off 
       ? entity_state::on : entity_state::off;
     this->call_ha_service_(
-      entity_type,
-      ha_action_type::shuffle_set,
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::shuffle), shuffle}
-      }});
+      ServiceCall(entity_type, ha_action_type::shuffle_set, entity_id)
+        .add(ha_attr_type::shuffle, shuffle));
   } else if (button_type == button_type::volumeSlider) {
-    auto volume = esphome::str_snprintf("%.2f", 7, std::stoi(value) * 0.01f);
+    int32_t volume_pct;
+    if (!parse_int(value, volume_pct)) return;
+    std::string volume;
+    append_fixed(volume, volume_pct, 2);
     this->call_ha_service_(
-      entity_type,
-      ha_action_type::volume_set,
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::volume_level), volume}
-      }});
+      ServiceCall(entity_type, ha_action_type::volume_set, entity_id)
+        .coalesce()
+        .add(ha_attr_type::volume_level, volume));
+    this->apply_optimistic_update_(this->get_entity_(entity_id),
+      ha_attr_type::volume_level, volume);
   } else if (button_type == button_type::speakerSel) {
     this->call_ha_service_(
-      entity_type,
-      ha_action_type::select_source,
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::source), value}
-      }});
+      ServiceCall(entity_type, ha_action_type::select_source, entity_id)
+        .add(ha_attr_type::source, value));
   } else if (button_type == button_type::modeMediaPlayer) {
     auto entity = this->get_entity_(entity_id);
     if (entity == nullptr) return;
-    auto source_list_str = entity->get_attribute(ha_attr_type::source_list);
-    if (source_list_str.empty()) return;
-    std::vector<std::string> source_list;
-    split_str(',', source_list_str, source_list);
-    uint8_t index = stoi(value);
-    if (source_list.size() <= index) return;
+    auto &source_list_str = entity->get_attribute(ha_attr_type::source_list);
+    std::string source;
+    uint32_t index;
+    if (!parse_uint(value, index) ||
+        !get_item(',', source_list_str, index, source)) {
+      return;
+    }
     this->call_ha_service_(
-      entity_type,
-      ha_action_type::select_source,
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::source), source_list.at(index)}
-      }});
+      ServiceCall(entity_type, ha_action_type::select_source, entity_id)
+        .add(ha_attr_type::source, source));
   }
   // light cards
   else if (button_type == button_type::brightnessSlider) {
-    if (value.empty()) return;
+    int32_t brightness;
+    if (!parse_int(value, brightness)) return;
+    // scale 0-100 to ha brightness range
+    std::string ha_brightness;
+    append_number(ha_brightness, static_cast<int>(
+      scale_value(brightness, {0, 100}, {0, 255})));
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::turn_on, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        // scale 0-100 to ha brightness range
-        {to_string(ha_attr_type::brightness), std::to_string(
-          static_cast<int>(
-            scale_value(std::stoi(value), {0, 100}, {0, 255})
-          ))}
-      }});
+      ServiceCall(entity_type, ha_action_type::turn_on, entity_id)
+        .coalesce()
+        .add(ha_attr_type::brightness, ha_brightness));
+    auto entity = this->get_entity_(entity_id);
+    // note: HA turns the light off when the brightness is 0
+    this->apply_optimistic_on_off_(entity, brightness > 0);
+    if (brightness > 0)
+      this->apply_optimistic_update_(entity, ha_attr_type::brightness, ha_brightness);
   } else if (button_type == button_type::colorTempSlider) {
-    if (value.empty()) return;
+    int32_t color_temp;
+    if (!parse_int(value, color_temp)) return;
     auto entity = this->get_entity_(entity_id);
     if (entity == nullptr) return;
-    auto &minstr = entity->get_attribute(ha_attr_type::min_mireds);
-    auto &maxstr = entity->get_attribute(ha_attr_type::max_mireds);
-    uint16_t min_mireds = minstr.empty() ? 153 : std::stoi(minstr);
-    uint16_t max_mireds = maxstr.empty() ? 500 : std::stoi(maxstr);
+    uint16_t min_mireds = value_or_default(
+      entity->get_attribute(ha_attr_type::min_mireds), 153U);
+    uint16_t max_mireds = value_or_default(
+      entity->get_attribute(ha_attr_type::max_mireds), 500U);
     if (min_mireds >= max_mireds) {
       ESP_LOGW(TAG, "min/max mired range invalid %i>=%i", min_mireds, max_mireds);
       min_mireds = 153;
       max_mireds = 500;
     }
-    
+    // scale 0-100 from slider to color range of the light
+    std::string mireds;
+    append_number(mireds, static_cast<int>(scale_value(color_temp, {0, 100},
+      {static_cast<float>(min_mireds), static_cast<float>(max_mireds)})));
+
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::turn_on, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        // scale 0-100 from slider to color range of the light
-        {to_string(ha_attr_type::color_temp), std::to_string(
-          static_cast<int>(
-            scale_value(std::stoi(value), {0, 100},
-            {static_cast<double>(min_mireds), static_cast<double>(max_mireds)})
-          ))}
-      }});
+      ServiceCall(entity_type, ha_action_type::turn_on, entity_id)
+        .coalesce()
+        .add(ha_attr_type::color_temp, mireds));
   } else if (button_type == button_type::colorWheel) {
     if (value.empty()) return;
 
     std::vector<std::string> xy_tokens;
     split_str('|', value, xy_tokens);
-    if (xy_tokens.size() != 3) return;
+    float x, y, wh;
+    if (xy_tokens.size() != 3 ||
+        !parse_float(xy_tokens[0], x) ||
+        !parse_float(xy_tokens[1], y) ||
+        !parse_float(xy_tokens[2], wh) || wh <= 0.0f) {
+      return;
+    }
 
-    std::string rgb_str = to_string(
-        xy_to_rgb(
-          std::stod(xy_tokens[0]),
-          std::stod(xy_tokens[1]),
-          std::stod(xy_tokens[2])
-        ), ',', '[', ']');
+    std::string rgb_str = to_string(xy_to_rgb(x, y, wh), ',', '[', ']');
 
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::turn_on, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id}
-      }},
-      {{
-        {to_string(ha_attr_type::rgb_color), rgb_str}
-      }});
+      ServiceCall(entity_type, ha_action_type::turn_on, entity_id)
+        .coalesce()
+        .add_template(ha_attr_type::rgb_color, rgb_str));
   }
   // thermo/climate card
   else if (button_type == button_type::tempUpd) {
-    auto val = esphome::str_snprintf("%.1f", 6, std::stoi(value) * 0.1);
+    int32_t temperature;
+    if (!parse_int(value, temperature)) return;
+    std::string val;
+    append_fixed(val, temperature, 1);
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::set_temperature, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::temperature), val}
-      }});
+      ServiceCall(entity_type, ha_action_type::set_temperature, entity_id)
+        .coalesce()
+        .add(ha_attr_type::temperature, val));
   } else if (button_type == button_type::tempUpdHighLow) {
     std::vector<std::string> temp_values;
     split_str('|', value, temp_values);
-    auto temp_high = esphome::str_snprintf(
-      "%.1f", 6, std::stoi(temp_values[0]) * 0.1);
-    auto temp_low = esphome::str_snprintf(
-      "%.1f", 6, std::stoi(temp_values[1]) * 0.1);
+    int32_t high, low;
+    if (temp_values.size() != 2 ||
+        !parse_int(temp_values[0], high) ||
+        !parse_int(temp_values[1], low)) {
+      return;
+    }
+    std::string temp_high, temp_low;
+    append_fixed(temp_high, high, 1);
+    append_fixed(temp_low, low, 1);
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::set_temperature, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::target_temp_high), temp_high},
-        {to_string(ha_attr_type::target_temp_low), temp_low}
-      }});
+      ServiceCall(entity_type, ha_action_type::set_temperature, entity_id)
+        .coalesce()
+        .add(ha_attr_type::target_temp_high, temp_high)
+        .add(ha_attr_type::target_temp_low, temp_low));
   } else if (button_type == button_type::hvacAction) {
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::set_hvac_mode, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::hvac_mode), value}
-      }});
+      ServiceCall(entity_type, ha_action_type::set_hvac_mode, entity_id)
+        .add(ha_attr_type::hvac_mode, value));
   } else if (button_type == button_type::modePresetModes) {
     auto entity = this->get_entity_(entity_id);
     if (entity == nullptr) return;
     auto &modes_str = entity->get_attribute(ha_attr_type::preset_modes);
-    if (modes_str.empty()) return;
-    std::vector<std::string> modes;
-    split_str(',', modes_str, modes);
-    auto &selected_mode = modes.at(std::stoi(value));
+    std::string selected_mode;
+    uint32_t index;
+    if (!parse_uint(value, index) ||
+        !get_item(',', modes_str, index, selected_mode)) {
+      return;
+    }
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::set_preset_mode, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::preset_mode), selected_mode}
-      }});
+      ServiceCall(entity_type, ha_action_type::set_preset_mode, entity_id)
+        .add(ha_attr_type::preset_mode, selected_mode));
   } else if (button_type == button_type::modeSwingModes) {
     auto entity = this->get_entity_(entity_id);
     if (entity == nullptr) return;
     auto &modes_str = entity->get_attribute(ha_attr_type::swing_modes);
-    if (modes_str.empty()) return;
-    std::vector<std::string> modes;
-    split_str(',', modes_str, modes);
-    auto &selected_mode = modes.at(std::stoi(value));
+    std::string selected_mode;
+    uint32_t index;
+    if (!parse_uint(value, index) ||
+        !get_item(',', modes_str, index, selected_mode)) {
+      return;
+    }
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::set_swing_mode, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::swing_mode), selected_mode}
-      }});
+      ServiceCall(entity_type, ha_action_type::set_swing_mode, entity_id)
+        .add(ha_attr_type::swing_mode, selected_mode));
   } else if (button_type == button_type::modeFanModes) {
     auto entity = this->get_entity_(entity_id);
     if (entity == nullptr) return;
     auto &modes_str = entity->get_attribute(ha_attr_type::fan_modes);
-    if (modes_str.empty()) return;
-    std::vector<std::string> modes;
-    split_str(',', modes_str, modes);
-    auto &selected_mode = modes.at(std::stoi(value));
+    std::string selected_mode;
+    uint32_t index;
+    if (!parse_uint(value, index) ||
+        !get_item(',', modes_str, index, selected_mode)) {
+      return;
+    }
     this->call_ha_service_(
-      entity_type, 
-      ha_action_type::set_fan_mode, 
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::fan_mode), selected_mode}
-      }});
+      ServiceCall(entity_type, ha_action_type::set_fan_mode, entity_id)
+        .add(ha_attr_type::fan_mode, selected_mode));
   }
   // alarm card
   else if (
@@ -2040,17 +2009,9 @@ void NSPanelLovelace::process_button_press_(
       button_type == button_type::armNight ||
       button_type == button_type::armVacation ||
       button_type == button_type::disarm) {
-    auto action = std::string("alarm_").append(button_type);
-    if (value.empty()) {
-      this->call_ha_service_(entity_type, action.c_str(), entity_id);
-    } else {
-      this->call_ha_service_(
-        entity_type, action.c_str(), 
-        {{
-          {to_string(ha_attr_type::entity_id), entity_id},
-          {to_string(ha_attr_type::code), value}
-        }});
-    }
+    ServiceCall call(entity_type, "alarm_", button_type.c_str(), entity_id);
+    if (!value.empty()) call.add(ha_attr_type::code, value);
+    this->call_ha_service_(call);
   } else if (button_type == button_type::opnSensorNotify) {
     auto entity = this->get_entity_(entity_id);
     if (entity == nullptr) return;
@@ -2077,51 +2038,39 @@ void NSPanelLovelace::process_button_press_(
       button_type == button_type::modeSelect) {
     auto entity = this->get_entity_(entity_id);
     if (entity == nullptr) return;
-    auto options_str = entity->get_attribute(ha_attr_type::options);
-    if (options_str.empty()) return;
-    std::vector<std::string> options;
-    split_str(',', options_str, options);
-    uint8_t index = stoi(value);
-    if (options.size() <= index) return;
+    auto &options_str = entity->get_attribute(ha_attr_type::options);
+    std::string option;
+    uint32_t index;
+    if (!parse_uint(value, index) ||
+        !get_item(',', options_str, index, option)) {
+      return;
+    }
     this->call_ha_service_(
-      entity_type,
-      ha_action_type::select_option,
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::option), options.at(index)}
-      }});
+      ServiceCall(entity_type, ha_action_type::select_option, entity_id)
+        .add(ha_attr_type::option, option));
   }
   // light
   else if (button_type == button_type::modeLight) {
     auto entity = this->get_entity_(entity_id);
     if (entity == nullptr) return;
-    auto effects_str = entity->get_attribute(ha_attr_type::effect_list);
-    if (effects_str.empty()) return;
-    std::vector<std::string> effects;
-    split_str(',', effects_str, effects);
-    uint8_t index = stoi(value);
-    if (effects.size() <= index) return;
+    auto &effects_str = entity->get_attribute(ha_attr_type::effect_list);
+    std::string effect;
+    uint32_t index;
+    if (!parse_uint(value, index) ||
+        !get_item(',', effects_str, index, effect)) {
+      return;
+    }
     this->call_ha_service_(
-      entity_type,
-      ha_action_type::turn_on,
-      {{
-        {to_string(ha_attr_type::entity_id), entity_id},
-        {to_string(ha_attr_type::effect), effects.at(index)}
-      }});
+      ServiceCall(entity_type, ha_action_type::turn_on, entity_id)
+        .add(ha_attr_type::effect, effect));
   }
   // timer card
   else if (esphome::str_startswith(button_type, entity_type::timer)) {
-    std::string service(button_type);
-    service[5] = '.';
-    if (value.empty()) {
-      this->call_ha_service_(service, entity_id);
-    } else {
-      this->call_ha_service_(service, 
-        {{
-          {to_string(ha_attr_type::entity_id), entity_id},
-          {to_string(ha_attr_type::duration), value}
-        }});
-    }
+    // e.g. timer-start -> timer.start
+    if (button_type.size() <= 6) return;
+    ServiceCall call(entity_type::timer, button_type.c_str() + 6, entity_id);
+    if (!value.empty()) call.add(ha_attr_type::duration, value);
+    this->call_ha_service_(call);
   }
 }
 
@@ -2152,85 +2101,122 @@ Entity* NSPanelLovelace::get_entity_(const std::string &entity_id) {
 }
 
 void NSPanelLovelace::call_ha_service_(
-    const std::string &service, const std::string &entity_id) {
-  this->call_ha_service_(service, {{to_string(ha_attr_type::entity_id), entity_id}});
+    const char *entity_type, const char *action, const std::string &entity_id) {
+  this->call_ha_service_(ServiceCall(entity_type, action, entity_id));
 }
 
-void NSPanelLovelace::call_ha_service_(
-    const char *entity_type, const std::string &action, const std::string &entity_id) {
-  this->call_ha_service_(entity_type, action, {{to_string(ha_attr_type::entity_id), entity_id}});
+void NSPanelLovelace::call_ha_service_(const ServiceCall &call) {
+  if (call.is_coalesced()) {
+    this->service_call_queue_.submit(call);
+    this->flush_service_calls_();
+    return;
+  }
+  // note: the pending calls for the entity are sent first so HA receives them in order
+  this->service_call_queue_.flush_entity(call.get_entity_id(), millis(),
+    [this](const api::HomeassistantServiceResponse &resp) {
+      this->send_ha_service_(resp);
+    });
+  this->flush_service_calls_();
+  api::HomeassistantServiceResponse resp;
+  call.build(resp);
+  this->send_ha_service_(resp);
 }
 
-void NSPanelLovelace::call_ha_service_(
-    const char *entity_type, const std::string &action,
-    const std::map<std::string, std::string> &data,
-    const std::map<std::string, std::string> &data_template) {
-  this->call_ha_service_(
-    std::string(entity_type).append(1, '.').append(action),
-    data, data_template);
+void NSPanelLovelace::send_ha_service_(const api::HomeassistantServiceResponse &resp) {
+  // note: the entity_id is always the first data value (see ServiceCall)
+  ESP_LOGD(TAG, "Call HA: %s -> %s", resp.service.c_str(),
+    resp.data.empty() ? "" : resp.data.front().value.c_str());
+  api::global_api_server->send_homeassistant_service_call(resp);
 }
 
-void NSPanelLovelace::call_ha_service_(
-    const std::string &service,
-    const std::map<std::string, std::string> &data,
-    const std::map<std::string, std::string> &data_template) {
-  api::HomeassistantServiceResponse resp;
-  resp.service = service;
-
-  auto it = data.find(to_string(ha_attr_type::entity_id));
-  if (it == data.end())
-    ESP_LOGD(TAG, "Call HA: %s -> %s", resp.service.c_str(), it->second.c_str());
-  else
-    ESP_LOGD(TAG, "Call HA: %s", resp.service.c_str());
-
-  for (auto &it : data) {
-    api::HomeassistantServiceMap kv;
-    kv.key = it.first;
-    kv.value = it.second;
-    resp.data.push_back(kv);
-  }
-  for (auto &it : data_template) {
-    api::HomeassistantServiceMap kv;
-    kv.key = it.first;
-    kv.value = it.second;
-    resp.data_template.push_back(kv);
+void NSPanelLovelace::flush_service_calls_() {
+  const uint32_t now = millis();
+  auto delay = this->service_call_queue_.flush(now,
+    [this](const api::HomeassistantServiceResponse &resp) {
+      this->send_ha_service_(resp);
+    });
+  if (delay == 0) {
+    if (this->service_call_flush_at_ != 0) this->cancel_timeout("svc_call");
+    this->service_call_flush_at_ = 0;
+    return;
   }
-
-  api::global_api_server->send_homeassistant_service_call(resp);
+  if (this->service_call_flush_at_ == now + delay) return;
+  this->service_call_flush_at_ = now + delay;
+  this->set_timeout("svc_call", delay, [this]() {
+    this->service_call_flush_at_ = 0;
+    this->flush_service_calls_();
+  });
 }
 
-void NSPanelLovelace::on_entity_state_update_(std::string entity_id, std::string state) {
-  this->on_entity_attribute_update_(entity_id, to_string(ha_attr_type::state), state);
-}
-void NSPanelLovelace::on_entity_attribute_update_(std::string entity_id, std::string attr, std::string attr_value) {
-  auto entity = this->get_entity_(entity_id);
-  if (entity == nullptr) return;
-  auto ha_attr = to_ha_attr(attr);
-  if (ha_attr == ha_attr_type::unknown) return;
+void NSPanelLovelace::on_entity_attribute_update_(Entity *entity, ha_attr_type attr, std::string &&value) {
+  // the calls in flight for the entity have been applied, send the pending ones
+  this->service_call_queue_.on_entity_update(entity->get_entity_id());
+  this->flush_service_calls_();
+
+  switch (this->optimistic_state_.reconcile(entity, attr, value)) {
+    case optimistic_result::confirmed:
+      // already rendered when the optimistic update was applied
+      ESP_LOGD(TAG, "HA confirmed: %s %s", entity->get_entity_id().c_str(), to_string(attr));
+      return;
+    case optimistic_result::held:
+      ESP_LOGV(TAG, "HA update held: %s %s", entity->get_entity_id().c_str(), to_string(attr));
+      return;
+    case optimistic_result::untracked:
+      break;
+  }
 
-  if (ha_attr == ha_attr_type::state) {
-    entity->set_state(attr_value);
+  if (attr == ha_attr_type::state) {
+    auto result = entity->set_state(std::move(value));
+    if (result == entity_state_result::filtered) {
+      ESP_LOGV(TAG, "HA update filtered: %s state='%s'",
+        entity->get_entity_id().c_str(), entity->get_state().c_str());
+      return;
+    }
+    if (result == entity_state_result::rate_limited) {
+      ESP_LOGV(TAG, "HA update rate limited: %s state='%s'",
+        entity->get_entity_id().c_str(), entity->get_state().c_str());
+      // render the latest state once the minimum interval has passed
+      this->set_timeout(std::string(entity->get_entity_id()).append("_rl"),
+          entity->get_state_filter_delay(), [this, entity] () {
+        if (entity->flush_state())
+          this->schedule_entity_render_(entity);
+      });
+      return;
+    }
   } else {
-    entity->set_attribute(ha_attr, attr_value);
+    entity->set_attribute(attr, std::move(value));
   }
 
-  ESP_LOGD(TAG, "HA update: %s %s='%s'",
-    entity_id.c_str(), attr.c_str(), 
-    ha_attr == ha_attr_type::state
+  ESP_LOGD(TAG, "HA update%s: %s %s='%s'", this->ha_syncing_ ? " (sync)" : "",
+    entity->get_entity_id().c_str(), to_string(attr),
+    attr == ha_attr_type::state
       ? entity->get_state().c_str()
-      : entity->get_attribute(ha_attr).c_str());
+      : entity->get_attribute(attr).c_str());
 
   // if (this->force_current_page_update_) return;
 
+  this->schedule_entity_render_(entity);
+}
+
+void NSPanelLovelace::schedule_entity_render_(Entity *entity) {
   // If there are lots of entity attributes that update within a short time
   // then this will queue lots of commands unnecessarily.
   // This re-schedules updates every time one happens within a 200ms period.
-  this->set_timeout(entity_id, 200, [this, entity_id] () {
+  // The whole page is rendered once the initial HA sync has finished.
+  if (this->ha_syncing_) return;
+  this->set_timeout(entity->get_entity_id(), 200, [this, entity] () {
+    auto &entity_id = entity->get_entity_id();
+    ESP_LOGV(TAG, "Entity notifications %s: sent:%" PRIu32 " skipped:%" PRIu32,
+      entity_id.c_str(), entity->get_notifications_sent(),
+      entity->get_notifications_skipped());
     if (this->force_current_page_update_) return;
     if (this->current_page_ == nullptr) return;
 
     if (this->screensaver_ != nullptr && 
         this->current_page_->is_type(page_type::screensaver)) {
+      // all weather updates within the period are sent as one weatherUpdate
+      if (this->screensaver_->is_weather_entity(entity))
+        this->send_weather_update_command_();
       force_current_page_update_ = 
         this->screensaver_->should_render_status_update(entity_id);
       return;
@@ -2277,100 +2263,61 @@ void NSPanelLovelace::on_entity_attribute_update_(std::string entity_id, std::st
 }
 
 void NSPanelLovelace::send_weather_update_command_() {
+  if (this->ha_syncing_) return;
   if (this->current_page_ != this->screensaver_)
     return;
   this->screensaver_->render(this->command_buffer_);
   this->send_buffered_command_();
 }
 
-void NSPanelLovelace::on_weather_state_update_(std::string entity_id, std::string state) {
-  if (this->screensaver_ == nullptr) return;
-  auto item = this->screensaver_->get_item<WeatherItem>(0);
-  if (item == nullptr) return;
-  item->set_icon_by_weather_condition(state);
-  this->send_weather_update_command_();
-}
-
-void NSPanelLovelace::on_weather_temperature_update_(std::string entity_id, std::string temperature) {
-  if (this->screensaver_ == nullptr) return;
-  auto item = this->screensaver_->get_item<WeatherItem>(0);
-  if (item == nullptr) return;
-  item->set_value(std::move(temperature));
-  this->send_weather_update_command_();
-}
-
-void NSPanelLovelace::on_weather_temperature_unit_update_(std::string entity_id, std::string temperature_unit) {
+void NSPanelLovelace::on_weather_forecast_update_(std::string forecast_json) {
   if (this->screensaver_ == nullptr) return;
-  WeatherItem::temperature_unit = std::move(temperature_unit);
-  this->screensaver_->set_items_render_invalid();
-  this->send_weather_update_command_();
-}
-
-void NSPanelLovelace::on_weather_forecast_update_(std::string entity_id, std::string forecast_json) {
-  if (this->screensaver_ == nullptr) return;
-  // todo: check if we are on the screensaver otherwise don't update
   // todo: implement color updates: "color~background~tTime~timeAMPM~tDate~tMainText~tForecast1~tForecast2~tForecast3~tForecast4~tForecast1Val~tForecast2Val~tForecast3Val~tForecast4Val~bar~tMainTextAlt2~tTimeAdd"
 
-  ArduinoJson::StaticJsonDocument<200> filter;
-  filter[0]["datetime"] = true;
-  filter[0]["condition"] = true;
-  filter[0]["temperature"] = true;
-
-  if (filter.overflowed()) {
-    ESP_LOGW(TAG, "Weather unparsable: filter overflowed");
-    return;
-  }
-  
-  // Note: Unfortunately the json received is nearly 6KB!
-  //       We filter the variables to consume less but it is still a lot,
-  //       so we need to allocate an appropriate amount of memory to read it.
-  SpiRamJsonDocument doc(psram_available() ? 7680 : 6144);
-  ArduinoJson::DeserializationError error = ArduinoJson::deserializeJson(
-    doc, (char *)forecast_json.data(), DeserializationOption::Filter(filter));
-  App.feed_wdt();
-
-  if (error || doc.overflowed()) {
-    ESP_LOGW(TAG, "Weather unparsable: %s", error ? error.c_str() : "doc overflow");
+  if (!this->weather_forecast_.update(forecast_json.data(), forecast_json.size())) {
+    ESP_LOGW(TAG, "Weather unparsable");
     return;
   }
+  this->weather_forecast_invalid_ = true;
+  // the items are updated when the screensaver is next shown
+  if (this->current_page_ != this->screensaver_) return;
+  this->update_weather_forecast_();
+  // coalesced with the weather entity updates
+  this->schedule_entity_render_(this->weather_entity_.get());
+}
 
-  this->command_buffer_.clear();
+void NSPanelLovelace::update_weather_forecast_() {
+  this->weather_forecast_invalid_ = false;
+  auto &forecast = this->weather_forecast_;
 
-  // check if forecast is hourly or daily
-  auto weather_entity_is_hourly = false;
-  if (doc.size() > 1) {
-    auto date1 = doc[0]["datetime"].as<const char *>();
-    auto date2 = doc[1]["datetime"].as<const char *>();
-    tm t{};
-    if (iso8601_to_tm(date1, t)) {
-      uint8_t hr = t.tm_hour;
-      if (iso8601_to_tm(date2, t) && t.tm_hour != hr) {
-        weather_entity_is_hourly = true;
-      }
-    }
+  time_t now = 0;
+#ifdef USE_TIME
+  if (this->time_id_.has_value()) {
+    auto time = this->time_id_.value()->now();
+    if (time.is_valid()) now = time.timestamp;
   }
-
-  char buff[16] = {};
-  uint8_t index = 1, item_count = this->screensaver_->get_items().size();
-
-  for (const ArduinoJson::JsonObject &item : doc.as<ArduinoJson::JsonArray>()) {
-    // can only display the first 4 items (minus 1 for the current weather)
-    if (index == item_count)
-      break;
-
+#endif
+  // remove the entries which are in the past, the forecast from HA
+  // may only be updated periodically (e.g. hourly)
+  if (now != 0) forecast.expire(now);
+
+  const uint8_t item_count = this->screensaver_->get_items().size();
+  auto weather_entity_is_hourly = forecast.is_hourly();
+  // can only display the first 4 items (minus 1 for the current weather)
+  for (uint8_t index = 1; index < item_count && index <= forecast.size(); index++) {
+    auto &item = forecast.at(index - 1);
     auto weatherItem = this->screensaver_->get_item<WeatherItem>(index);
     if (weatherItem == nullptr)
       continue;
 
-    weatherItem->set_icon_by_weather_condition(
-        item["condition"].as<std::string>());
+    weatherItem->set_icon_by_weather_condition(item.condition);
 
     // icon displayName
     // todo: import temperature symbol from config
     tm t{};
-    // Parse date e.g. 2023-08-22T21:00:00+00:00
-    if (!iso8601_to_tm(item["datetime"], t)) {
-      ESP_LOGW(TAG, "Weather 'datetime' unparsable: %s", item["datetime"].as<const char *>());
+    // the datetime (e.g. 2023-08-22T21:00:00+00:00) is parsed when the forecast is received
+    if (item.time == 0 || localtime_r(&item.time, &t) == nullptr) {
+      ESP_LOGW(TAG, "Weather 'datetime' unparsable: %s", item.datetime);
       // return;
       t = { 
         // second, minute, hour
@@ -2383,38 +2330,38 @@ void NSPanelLovelace::on_weather_forecast_update_(std::string entity_id, std::st
     }
 
     if (weather_entity_is_hourly) {
-      // ESPTime now; now.strftime(datefmt);
-      strftime(buff, sizeof(buff), this->time_format_.c_str(), &t);
-      weatherItem->set_display_name(buff);
+      std::string display_name;
+      this->time_format_.format(t, display_name);
+      weatherItem->set_display_name(display_name);
     } else {
       switch(t.tm_wday) {
         case 0:
           weatherItem->set_display_name(
-            get_translation(translation_item::dow_sun));
+            get_translation(static_translation::dow_sun));
           break;
         case 1:
           weatherItem->set_display_name(
-            get_translation(translation_item::dow_mon));
+            get_translation(static_translation::dow_mon));
           break;
         case 2:
           weatherItem->set_display_name(
-            get_translation(translation_item::dow_tue));
+            get_translation(static_translation::dow_tue));
           break;
         case 3:
           weatherItem->set_display_name(
-            get_translation(translation_item::dow_wed));
+            get_translation(static_translation::dow_wed));
           break;
         case 4:
           weatherItem->set_display_name(
-            get_translation(translation_item::dow_thu));
+            get_translation(static_translation::dow_thu));
           break;
         case 5:
           weatherItem->set_display_name(
-            get_translation(translation_item::dow_fri));
+            get_translation(static_translation::dow_fri));
           break;
         case 6:
           weatherItem->set_display_name(
-            get_translation(translation_item::dow_sat));
+            get_translation(static_translation::dow_sat));
           break;
         default:
           weatherItem->set_display_name("DOW_UNK");
@@ -2422,12 +2369,27 @@ void NSPanelLovelace::on_weather_forecast_update_(std::string entity_id, std::st
       }
     }
     
-    snprintf(buff, sizeof(buff), "%.1f", item["temperature"].as<float>());
-    weatherItem->set_value(buff);
-
-    ++index;
+    std::string value;
+    append_float(value, std::isnan(item.temperature) ? 0.0f : item.temperature, 1);
+    weatherItem->set_value(value);
   }
-  this->send_weather_update_command_();
+  // the expired entries leave fewer entries than items, blank the
+  // remaining items so they don't repeat the previous values
+  for (uint8_t index = forecast.size() + 1; index < item_count; index++) {
+    auto weatherItem = this->screensaver_->get_item<WeatherItem>(index);
+    if (weatherItem != nullptr) weatherItem->clear();
+  }
+
+  // refresh the items when the first entry expires
+  auto expiry = forecast.get_next_expiry();
+  if (now == 0 || expiry <= now) return;
+  this->set_timeout("weather_forecast", (expiry - now + 1) * 1000, [this]() {
+    this->weather_forecast_invalid_ = true;
+    // skip the refresh until the screensaver is shown
+    if (this->current_page_ != this->screensaver_) return;
+    this->update_weather_forecast_();
+    this->send_weather_update_command_();
+  });
 }
 
 } // namespace nspanel_lovelace
@@ -4,7 +4,6 @@
 
 #include <functional>
 #include <memory>
-#include <map>
 #include <queue>
 #include <stdint.h>
 #include <utility>
@@ -35,8 +34,15 @@
 #include "esphome/components/time/real_time_clock.h"
 #endif
 
+#include "active_controls.h"
 #include "config.h"
+#include "datetime_format.h"
 #include "entity.h"
+#include "forecast.h"
+#include "input_coalescer.h"
+#include "optimistic_state.h"
+#include "service_call.h"
+#include "service_call_queue.h"
 #include "types.h"
 #include "helpers.h"
 #include "page_base.h"
@@ -91,8 +97,8 @@ public:
 
 #ifdef USE_TIME
   void set_time_id(time::RealTimeClock *time_id) { this->time_id_ = time_id; }
-  void set_date_format(const std::string &date_format) { this->date_format_ = date_format; }
-  void set_time_format(const std::string &time_format) { this->time_format_ = time_format; }
+  void set_date_format(const std::string &date_format) { this->date_format_.compile(date_format); }
+  void set_time_format(const std::string &time_format) { this->time_format_.compile(time_format); }
 
   void update_date(const char *date_format = "") { this->update_datetime(datetime_mode::date, date_format); }
   void update_time(const char *time_format = "") { this->update_datetime(datetime_mode::time, "", time_format); }
@@ -107,7 +113,16 @@ public:
   void set_display_inactive_dim(uint8_t inactive);
   // Note: this can be used without parameters to update the display without changing the levels
   void set_display_dim(uint8_t inactive = UINT8_MAX, uint8_t active = UINT8_MAX);
-  void set_weather_entity_id(const std::string &weather_entity_id) { this->weather_entity_id_ = weather_entity_id; }
+  // The time (ms) repeated input events are coalesced for, per button type (e.g. brightnessSlider)
+  void set_input_interval(uint16_t interval_ms) { this->input_coalescer_.set_default_interval(interval_ms); }
+  void set_input_interval(const std::string &button_type, uint16_t interval_ms) {
+    this->input_coalescer_.set_interval(button_type, interval_ms);
+  }
+  uint32_t get_input_events_received() const { return this->input_coalescer_.get_events_received(); }
+  uint32_t get_input_events_sent() const { return this->input_coalescer_.get_events_sent(); }
+  void set_weather_entity_id(const std::string &weather_entity_id) {
+    this->weather_entity_ = this->create_entity(weather_entity_id);
+  }
 
   void render_screensaver() { this->render_page_(render_page_option::screensaver); }
   void render_next_page() { this->render_page_(render_page_option::next); }
@@ -167,13 +182,32 @@ protected:
 #endif
   void send_nextion_command_(const std::string &command);
 
-  void subscribe_homeassistant_state_attr(
-      void (NSPanelLovelace::*callback)(std::string, std::string, std::string),
-      std::string entity_id, std::string attribute) {
-    auto f = std::bind(callback, this, entity_id, attribute, std::placeholders::_1);
-    api::global_api_server->
-      subscribe_home_assistant_state(entity_id, optional<std::string>(attribute), f);
-  }
+  // A Home Assistant state/attribute subscription
+  struct HaSubscription {
+    const std::string *entity_id;
+    // nullptr when only used by the screensaver forecast
+    Entity *entity;
+    ha_attr_type attr;
+    // the weather forecast is parsed into the screensaver items instead of being stored
+    bool forecast;
+    // popup only attributes are held in 'pending' until the popup is first opened
+    bool deferred;
+    PooledString pending;
+  };
+  void setup_subscriptions_();
+  void on_ha_subscription_update_(HaSubscription &sub, std::string value);
+  // Stores the deferred popup attributes in the entity and keeps them updated from now on
+  void load_popup_attributes_(Entity *entity);
+  std::vector<HaSubscription> ha_subscriptions_;
+  uint16_t deferred_subscriptions_ = 0;
+  // While HA sends the current value of every subscription after the API connects
+  // entities are updated without rendering, the current page is rendered once afterwards
+  void update_ha_sync_state_();
+  bool api_connected_ = false;
+  bool ha_syncing_ = false;
+  uint32_t ha_sync_start_ = 0;
+  uint32_t ha_sync_last_update_ = 0;
+  uint16_t ha_sync_updates_ = 0;
 
   bool process_data_();
   size_t find_page_index_by_uuid_(const std::string &uuid) const;
@@ -183,7 +217,22 @@ protected:
   void process_display_command_queue_();
   void process_button_press_(std::string &entity_id,
     const std::string &button_type,
-    const std::string &value = "", bool called_from_timeout = false);
+    const std::string &value = "", bool coalesced = false);
+  // Processes the coalesced input events which are due and schedules the next check
+  void flush_input_();
+  InputCoalescer input_coalescer_;
+  // when the next flush_input_ is scheduled (millis), 0 if not scheduled
+  uint32_t input_flush_at_ = 0;
+  ActiveControls active_controls_;
+  // Updates the entity before HA confirms the change and renders the current page (or popup)
+  void apply_optimistic_update_(Entity *entity, ha_attr_type attr, const std::string &value);
+  // Only applied when the entity state is currently on or off
+  void apply_optimistic_on_off_(Entity *entity, bool on);
+  // Rolls back the optimistic updates which were not confirmed in time and schedules the next check
+  void expire_optimistic_updates_();
+  OptimisticState optimistic_state_;
+  // when the next expire_optimistic_updates_ is scheduled (millis), 0 if not scheduled
+  uint32_t optimistic_expire_at_ = 0;
   StatefulPageItem* get_page_item_(const std::string &uuid);
   Entity* get_entity_(const std::string &entity_id);
 
@@ -199,6 +248,21 @@ protected:
   bool render_popup_page_update_(StatefulPageItem *entity);
   void render_light_detail_update_(StatefulPageItem *entity);
   void render_timer_detail_update_(StatefulPageItem *entity);
+  void render_timer_detail_tick_();
+  bool get_timer_seconds_remaining_(uint32_t &seconds);
+  void render_timer_detail_remaining_(uint16_t minutes, uint16_t seconds);
+  void set_timer_detail_tick_(StatefulPageItem *item);
+  // The timer popup command is cached so the per second updates only format the time remaining
+  struct TimerDetailCache {
+    std::string prefix;
+    std::string suffix;
+    // 0 when the timer is not active
+    time_t finishes_at = 0;
+    uint32_t seconds_displayed = 0;
+    // the item the 1s interval updates, nullptr when the interval is not set
+    StatefulPageItem *ticking_item = nullptr;
+  };
+  TimerDetailCache timer_detail_;
   void render_cover_detail_update_(StatefulPageItem *item);
   void render_climate_detail_update_(StatefulPageItem *item);
   void render_climate_detail_update_(Entity *entity, const std::string &uuid = "");
@@ -207,10 +271,10 @@ protected:
 
 #ifdef USE_TIME
   void setup_time_();
-  // Check and update clock if required
+  // Check and update clock if required, then schedule the next check for the start of the next minute
   void check_time_();
   optional<time::RealTimeClock *> time_id_{};
-  std::string date_format_, time_format_;
+  DateTimeFormat date_format_, time_format_;
   uint8_t now_minute_, now_hour_;
   bool time_configured_;
 #endif
@@ -219,39 +283,34 @@ protected:
   uint8_t display_inactive_dim_ = 50;
   
   void call_ha_service_(
-    const std::string& service, const std::string& entity_id);
-  void call_ha_service_(
-    const char *entity_type, const std::string &action, const std::string& entity_id);
-  void call_ha_service_(
-    const char *entity_type, const std::string &action,
-    const std::map<std::string, std::string> &data,
-    const std::map<std::string, std::string> &data_template = {});
-  void call_ha_service_(
-    const std::string& service,
-    const std::map<std::string, std::string> &data,
-    const std::map<std::string, std::string> &data_template = {});
-  void on_entity_state_update_(std::string entity_id, std::string state);
-  void on_entity_attribute_update_(
-    std::string entity_id, std::string attr_name, std::string attr_value);
-
-  void on_weather_state_update_(std::string entity_id, std::string state);
-  void on_weather_temperature_update_(std::string entity_id, std::string temperature);
-  void on_weather_temperature_unit_update_(std::string entity_id, std::string temperature_unit);
-  void on_weather_forecast_update_(std::string entity_id, std::string forecast_json);
+    const char *entity_type, const char *action, const std::string &entity_id);
+  void call_ha_service_(const ServiceCall &call);
+  void send_ha_service_(const api::HomeassistantServiceResponse &resp);
+  // Sends the coalesced service calls which are due and schedules the next check
+  void flush_service_calls_();
+  ServiceCallQueue service_call_queue_;
+  // when the next flush_service_calls_ is scheduled (millis), 0 if not scheduled
+  uint32_t service_call_flush_at_ = 0;
+  void on_entity_attribute_update_(Entity *entity, ha_attr_type attr, std::string &&value);
+  void schedule_entity_render_(Entity *entity);
+
+  void on_weather_forecast_update_(std::string forecast_json);
+  // Updates the screensaver items from the cached forecast
+  void update_weather_forecast_();
+  WeatherForecast weather_forecast_;
+  bool weather_forecast_invalid_ = false;
   void send_weather_update_command_();
-  std::string weather_entity_id_;
+  std::shared_ptr<Entity> weather_entity_;
   std::string language_;
 
   std::queue<std::string> command_queue_;
   unsigned long command_last_sent_ = 0;
 
-  bool button_press_timeout_set_ = false;
-  std::string button_press_uuid_;
-  std::string button_press_type_;
-  std::string button_press_value_;
-
   uint8_t current_page_index_ = 0;
   std::string popup_page_current_uuid_;
+  // The last entityUpdateDetail sent for the popup, used to skip identical
+  // updates while one of the popup's controls is being used
+  std::string popup_detail_last_;
   Page* current_page_ = nullptr;
   bool force_current_page_update_ = false;
   Screensaver* screensaver_ = nullptr;
@@ -0,0 +1,82 @@
+#include "optimistic_state.h"
+#include "helpers.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+namespace {
+
+const std::string &get_value(const Entity *entity, ha_attr_type attr) {
+  return attr == ha_attr_type::state
+    ? entity->get_state()
+    : entity->get_attribute(attr);
+}
+
+void set_value(Entity *entity, ha_attr_type attr, std::string &&value) {
+  if (attr == ha_attr_type::state) {
+    entity->set_state(std::move(value));
+  } else {
+    entity->set_attribute(attr, std::move(value));
+  }
+}
+
+// HA may format numbers differently to the value sent (e.g. 0.5 and 0.50)
+bool values_match(const std::string &a, const std::string &b) {
+  if (a == b) return true;
+  float a_value, b_value;
+  return parse_float(a, a_value) && parse_float(b, b_value) &&
+    std::fabs(a_value - b_value) < 0.001f;
+}
+
+} // namespace
+
+OptimisticState::Update *OptimisticState::find_(const Entity *entity, ha_attr_type attr) {
+  for (auto &update : this->updates_) {
+    if (update.entity == entity && update.attr == attr) return &update;
+  }
+  return nullptr;
+}
+
+void OptimisticState::apply(Entity *entity, ha_attr_type attr,
+    const std::string &value, uint32_t now) {
+  auto update = this->find_(entity, attr);
+  if (update == nullptr) {
+    // note: the previous value is kept when the same value is updated again (e.g. slider drags)
+    this->updates_.push_back({entity, attr, value, get_value(entity, attr), "", false, 0});
+    update = &this->updates_.back();
+  } else {
+    update->value = value;
+  }
+  update->expires = now + this->timeout_;
+  set_value(entity, attr, std::string(value));
+}
+
+optimistic_result OptimisticState::reconcile(Entity *entity, ha_attr_type attr, std::string &value) {
+  auto update = this->find_(entity, attr);
+  if (update == nullptr) return optimistic_result::untracked;
+  if (!values_match(update->value, value)) {
+    update->reported = std::move(value);
+    update->has_reported = true;
+    return optimistic_result::held;
+  }
+  // store the value exactly as HA sent it
+  set_value(entity, attr, std::move(value));
+  this->updates_.erase(this->updates_.begin() + (update - this->updates_.data()));
+  this->confirmed_++;
+  return optimistic_result::confirmed;
+}
+
+void OptimisticState::rollback_(Update &update) {
+  if (update.has_reported) {
+    set_value(update.entity, update.attr, std::move(update.reported));
+  } else if (update.attr == ha_attr_type::state) {
+    update.entity->set_state(std::move(update.previous));
+  } else {
+    update.entity->restore_attribute(update.attr, update.previous);
+  }
+}
+
+} // namespace nspanel_lovelace
+} // namespace esphome
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "entity.h"
+#include "types.h"
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+enum class optimistic_result : uint8_t {
+  // the value is not waiting to be confirmed
+  untracked,
+  // HA reported the optimistic value
+  confirmed,
+  // HA reported a different value, it is applied if the
+  // optimistic value is not confirmed before the timeout
+  held
+};
+
+// Tracks the entity values which are set locally after a service call so the
+// screen can be updated without waiting for HA to send the new state back.
+// When HA doesn't confirm the value before the timeout the last value HA
+// reported (or the value before the update) is restored.
+class OptimisticState {
+public:
+  void set_timeout(uint16_t timeout_ms) { this->timeout_ = timeout_ms; }
+
+  // Sets the entity state (ha_attr_type::state) or attribute,
+  // the value must be in the format HA sends it in
+  void apply(Entity *entity, ha_attr_type attr, const std::string &value, uint32_t now);
+  // Checks a value received from HA against the optimistic value.
+  // note: the value is moved from unless the result is untracked
+  optimistic_result reconcile(Entity *entity, ha_attr_type attr, std::string &value);
+
+  // Rolls back the values which were not confirmed in time and calls fn(entity) for each.
+  // Returns the time (ms) until the next value expires, 0 if none are waiting.
+  template <typename F>
+  uint32_t expire(uint32_t now, F &&fn) {
+    uint32_t next_delay = 0;
+    for (auto it = this->updates_.begin(); it != this->updates_.end();) {
+      if (static_cast<int32_t>(now - it->expires) >= 0) {
+        Entity *entity = it->entity;
+        this->rollback_(*it);
+        it = this->updates_.erase(it);
+        this->rolled_back_++;
+        fn(entity);
+        continue;
+      }
+      const uint32_t delay = it->expires - now;
+      if (next_delay == 0 || delay < next_delay) next_delay = delay;
+      ++it;
+    }
+    return next_delay;
+  }
+
+  uint32_t get_confirmed() const { return this->confirmed_; }
+  uint32_t get_rolled_back() const { return this->rolled_back_; }
+
+protected:
+  struct Update {
+    Entity *entity;
+    ha_attr_type attr;
+    // the optimistic value
+    std::string value;
+    // the value before the first optimistic update (as returned by get_attribute)
+    std::string previous;
+    // the last value HA reported while waiting for confirmation
+    std::string reported;
+    bool has_reported;
+    uint32_t expires;
+  };
+  std::vector<Update> updates_;
+  uint16_t timeout_ = OPTIMISTIC_UPDATE_TIMEOUT;
+  uint32_t confirmed_ = 0;
+  uint32_t rolled_back_ = 0;
+
+  Update *find_(const Entity *entity, ha_attr_type attr);
+  void rollback_(Update &update);
+};
+
+} // namespace nspanel_lovelace
+} // namespace esphome
@@ -2,6 +2,7 @@
 
 #include "config.h"
 #include "helpers.h"
+#include "translations.h"
 #include "types.h"
 #include <algorithm>
 
@@ -100,10 +101,10 @@ std::string &PageItem_Icon::render_(std::string &buffer) {
   if (this->icon_value_.empty()) { 
     return buffer.append(1, SEPARATOR);
   }
-  return buffer
+  buffer
     .append(this->icon_value_)
-    .append(1, SEPARATOR)
-    .append(this->get_icon_color_str());
+    .append(1, SEPARATOR);
+  return append_number(buffer, this->icon_color_);
 }
 
 /*
@@ -213,7 +214,9 @@ void StatefulPageItem::on_entity_type_change(const char *type) {
   }
   this->icon_value_overridden_ = false;
 
+  this->update_presentation_(type);
   this->set_on_state_callback_(type);
+  this->entity_->set_subscriber_mask(this, this->get_entity_notify_mask_(type));
 
   this->set_render_invalid();
 
@@ -234,6 +237,7 @@ void StatefulPageItem::on_entity_state_change(const std::string &state) {
 void StatefulPageItem::on_entity_attribute_change(ha_attr_type attr, const std::string &value) {
   // this class only needs to react to the following attributes
   if (attr == ha_attr_type::device_class) {
+    this->update_presentation_(this->get_type());
     if (!this->icon_value_overridden_) {
       if (this->entity_->is_type(entity_type::sensor)) {
         this->icon_default_value_ = this->icon_value_ =
@@ -256,6 +260,33 @@ void StatefulPageItem::on_entity_attribute_change(ha_attr_type attr, const std::
   this->set_render_invalid();
 }
 
+entity_notify_mask_t StatefulPageItem::get_entity_notify_mask_(const char *type) const {
+  // see on_entity_attribute_change
+  return entity_notify::type | entity_notify::state |
+    entity_notify_attr(ha_attr_type::device_class, ha_attr_type::media_content_type);
+}
+
+void StatefulPageItem::update_presentation_(const char *type) {
+  this->presentation_ = {};
+  if (type == nullptr) return;
+
+  auto &device_class = this->entity_->get_attribute(ha_attr_type::device_class);
+  if (type == entity_type::binary_sensor) {
+    this->presentation_.icon_on = get_value_or_default(SENSOR_ON_ICON_MAP,
+      device_class, static_cast<const char *>(icon_t::checkbox_marked_circle));
+    this->presentation_.icon_off = get_value_or_default(SENSOR_OFF_ICON_MAP,
+      device_class, static_cast<const char *>(icon_t::radiobox_blank));
+  } else if (type == entity_type::cover) {
+    this->presentation_.cover_icons = find_value(COVER_MAP,
+      device_class.c_str(), entity_cover_type::window);
+    this->presentation_.cover_device_class_found =
+      find_value(COVER_MAP, device_class.c_str()) != nullptr;
+  }
+
+  this->presentation_.state_translations = find_prefix_range(
+    TRANSLATION_MAP, std::string(type).append(1, '.'));
+}
+
 void StatefulPageItem::set_on_state_callback_(const char *type) {
   if (type == entity_type::light ||
       type == entity_type::switch_ ||
@@ -299,7 +330,8 @@ uint16_t StatefulPageItem::get_render_buffer_reserve_() const {
   // try to guess the required size of the buffer to reduce heap fragmentation
   return strlen(this->render_type_) + 
       this->uuid_.length() + 6 +
-      this->get_icon_color_str().length() + 
+      // icon colour is up to 5 digits
+      5 + 
       // icon is 4 char long + separator chars
       9;
 }
@@ -323,9 +355,7 @@ void StatefulPageItem::state_binary_sensor_fn(StatefulPageItem *me) {
     if (!me->icon_color_overridden_)
       me->icon_color_ = 64909u; // yellow
     if (!me->icon_value_overridden_) {
-      me->icon_value_ = get_value_or_default(SENSOR_ON_ICON_MAP,
-        me->get_attribute(ha_attr_type::device_class),
-        static_cast<const char *>(icon_t::checkbox_marked_circle));
+      me->icon_value_ = me->presentation_.icon_on;
     }
   } else {
     if (!me->icon_color_overridden_) {
@@ -335,9 +365,7 @@ void StatefulPageItem::state_binary_sensor_fn(StatefulPageItem *me) {
         me->icon_color_ = 38066u; // grey
     }
     if (!me->icon_value_overridden_) {
-      me->icon_value_ = get_value_or_default(SENSOR_OFF_ICON_MAP,
-        me->get_attribute(ha_attr_type::device_class),
-        static_cast<const char *>(icon_t::radiobox_blank));
+      me->icon_value_ = me->presentation_.icon_off;
     }
   }
 }
@@ -352,15 +380,13 @@ void StatefulPageItem::state_cover_fn(StatefulPageItem *me) {
       me->icon_color_ = 38066u; // grey
   }
   
-  if (!me->icon_value_overridden_) {
-    std::array<const char *, 4> icons{};
-    if (try_get_value(COVER_MAP, icons,
-        me->get_attribute(ha_attr_type::device_class))) {
-      if (me->is_state(entity_state::closed))
-        me->icon_value_ = icons.at(1);
-      else
-        me->icon_value_ = icons.at(0);
-    }
+  if (!me->icon_value_overridden_ &&
+      me->presentation_.cover_device_class_found) {
+    auto &icons = *me->presentation_.cover_icons;
+    if (me->is_state(entity_state::closed))
+      me->icon_value_ = icons.at(1);
+    else
+      me->icon_value_ = icons.at(0);
   }
 }
 
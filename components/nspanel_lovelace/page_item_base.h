@@ -91,9 +91,6 @@ public:
   const std::string &get_icon_value() const { return this->icon_value_; }
   bool is_icon_value_overridden() const { return this->icon_value_overridden_; }
   uint16_t get_icon_color() const { return this->icon_color_; }
-  std::string get_icon_color_str() const {
-    return std::to_string(this->icon_color_);
-  }
 
   virtual void set_icon_value(const std::string &value);
   virtual void reset_icon_value();
@@ -196,19 +193,39 @@ public:
   const std::string &get_entity_id() const { return this->entity_->get_entity_id(); }
   bool is_state(const std::string &state) const { return this->entity_->is_state(state); }
   const std::string &get_state() const { return this->entity_->get_state(); }
+  const std::string &get_attribute(ha_attr_type attr) const {
+    return this->entity_->get_attribute(attr);
+  }
   const std::string &get_attribute(
-      ha_attr_type attr, const std::string &default_value = "") const {
+      ha_attr_type attr, const std::string &default_value) const {
     return this->entity_->get_attribute(attr, default_value);
   }
   Entity* get_entity() const { return this->entity_.get(); }
+  // The cover icons for the device_class (or 'window' if not found), nullptr if not a cover
+  const std::array<const char *, 4> *get_cover_icons() const { return this->presentation_.cover_icons; }
 
 protected:
+  // Lookups which only depend on the entity type and device_class so they
+  // don't need to be repeated on every state change (see update_presentation_)
+  struct Presentation {
+    const char *icon_on = nullptr;
+    const char *icon_off = nullptr;
+    const std::array<const char *, 4> *cover_icons = nullptr;
+    bool cover_device_class_found = false;
+    // type specific state translations e.g. 'binary_sensor.on'
+    FrozenCharMapRange<const char *> state_translations;
+  };
+
   const std::shared_ptr<Entity> entity_;
+  Presentation presentation_;
   // A function which modifies the entity when the state changes
   std::function<void(StatefulPageItem *)> on_state_callback_;
   const char *render_type_;
 
   virtual void set_on_state_callback_(const char *type);
+  void update_presentation_(const char *type);
+  // The entity changes this item needs to be notified about for the given entity type
+  virtual entity_notify_mask_t get_entity_notify_mask_(const char *type) const;
 
   static void state_on_off_fn(StatefulPageItem *me);
   static void state_binary_sensor_fn(StatefulPageItem *me);
@@ -110,10 +110,13 @@ std::string &StatusIconItem::render_(std::string &buffer) {
  * =============== WeatherItem ===============
  */
 
+static const std::string DEFAULT_TEMPERATURE_UNIT = "°C";
+
 WeatherItem::WeatherItem(const std::string &uuid) :
     PageItem(uuid), PageItem_Icon(this, 63878u), // change the default icon color: #ff3131 (red)
     PageItem_DisplayName(this),
-    PageItem_Value(this, "0.0"), float_value_(0.0f) {
+    PageItem_Value(this, "0.0"), float_value_(0.0f),
+    temperature_unit_(&DEFAULT_TEMPERATURE_UNIT) {
   this->render_buffer_.reserve(this->get_render_buffer_reserve_());
 }
 
@@ -122,7 +125,8 @@ WeatherItem::WeatherItem(
     const std::string &value, const char *weather_condition) :
     PageItem(uuid), PageItem_Icon(this, 63878u), 
     PageItem_DisplayName(this, display_name), 
-    PageItem_Value(this, value), float_value_(0.0f) {
+    PageItem_Value(this, value), float_value_(0.0f),
+    temperature_unit_(&DEFAULT_TEMPERATURE_UNIT) {
   this->set_icon_by_weather_condition(weather_condition);
   this->render_buffer_.reserve(this->get_render_buffer_reserve_());
 }
@@ -139,25 +143,33 @@ void WeatherItem::set_icon_by_weather_condition(const std::string &condition) {
 }
 
 bool WeatherItem::set_value(const std::string &value) {
-  if (sscanf(value.c_str(), "%f", &this->float_value_) != 1)
+  if (!parse_float(value, this->float_value_))
     return false;
   this->value_ = value;
   this->render_invalid_ = true;
   return true;
 }
 
+void WeatherItem::clear() {
+  this->icon_value_.clear();
+  this->display_name_.clear();
+  this->value_.clear();
+  this->float_value_ = 0.0f;
+  this->set_render_invalid();
+}
+
 std::string &WeatherItem::render_(std::string &buffer) {
   // skip: type,internalName
   buffer.append(2, SEPARATOR);
   PageItem_Icon::render_(buffer).append(1, SEPARATOR);
   PageItem_DisplayName::render_(buffer).append(1, SEPARATOR);
+  // cleared items have no value or unit
+  if (this->value_.empty()) return buffer;
   // allow the value to be fomatted based on locale instead of using the raw string value
-  return buffer.append(esphome::str_snprintf("%.1f", 6, this->float_value_))
-      .append(WeatherItem::temperature_unit);
+  return append_float(buffer, this->float_value_, 1)
+      .append(*this->temperature_unit_);
 }
 
-std::string WeatherItem::temperature_unit = "°C";
-
 /*
  * =============== AlarmButtonItem ===============
  */
@@ -94,12 +94,17 @@ public:
 
   void set_icon_by_weather_condition(const std::string &condition);
   bool set_value(const std::string &value) override;
+  // Blanks the icon, display name and value (e.g. when there is no forecast entry)
+  void clear();
 
-  // The temperature unit all weather items will use
-  static std::string temperature_unit;
+  // The temperature unit is shared by all weather items (see Screensaver)
+  void set_temperature_unit(const std::string *temperature_unit) {
+    this->temperature_unit_ = temperature_unit;
+  }
 
 protected:
   float float_value_;
+  const std::string *temperature_unit_;
 
   // output: ~~icon~iconColor~displayName~value
   std::string &render_(std::string &buffer) override;
@@ -19,6 +19,38 @@ void Screensaver::set_icon_right(std::shared_ptr<StatusIconItem> right_icon) {
   this->right_icon = std::move(right_icon);
 }
 
+void Screensaver::set_weather_entity(std::shared_ptr<Entity> weather_entity) {
+  if (this->weather_entity_) this->weather_entity_->remove_subscriber(this);
+  this->weather_entity_ = std::move(weather_entity);
+  if (!this->weather_entity_) return;
+  this->weather_entity_->add_subscriber(this, entity_notify::state |
+    entity_notify_attr(ha_attr_type::temperature, ha_attr_type::temperature_unit));
+
+  for (size_t i = 0; i < this->items_.size(); i++) {
+    auto item = this->get_item<WeatherItem>(i);
+    if (item == nullptr) continue;
+    item->set_temperature_unit(&this->temperature_unit_);
+  }
+}
+
+void Screensaver::on_entity_state_change(const std::string &state) {
+  auto item = this->get_item<WeatherItem>(0);
+  if (item == nullptr) return;
+  item->set_icon_by_weather_condition(state);
+}
+
+void Screensaver::on_entity_attribute_change(ha_attr_type attr, const std::string &value) {
+  if (attr == ha_attr_type::temperature) {
+    auto item = this->get_item<WeatherItem>(0);
+    if (item == nullptr) return;
+    item->set_value(value);
+  } else if (attr == ha_attr_type::temperature_unit) {
+    // note: the entity only notifies when the unit has changed
+    this->temperature_unit_ = value.empty() ? "°C" : value;
+    this->set_items_render_invalid();
+  }
+}
+
 // output: weatherUpd~(5x)[type~internalName~icon~iconColor~displayName~value]
 std::string &Screensaver::render(std::string &buffer) {
   buffer.assign(this->get_render_instruction());
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "entity.h"
 #include "page_base.h"
 #include "page_items.h"
 #include "page_visitor.h"
@@ -15,7 +16,7 @@ namespace nspanel_lovelace {
  * =============== Screensaver ===============
  */
 
-class Screensaver : public Page {
+class Screensaver : public Page, public IEntitySubscriber {
 public:
   Screensaver(const std::string &uuid) : Page(page_type::screensaver, uuid) {}
   virtual ~Screensaver() {}
@@ -41,7 +42,20 @@ public:
 
   virtual std::string &render_status_update(std::string &buffer);
 
+  // The weather entity is rendered by the first WeatherItem,
+  // note: call after the items have been added
+  void set_weather_entity(std::shared_ptr<Entity> weather_entity);
+  bool is_weather_entity(const Entity *entity) const {
+    return entity != nullptr && this->weather_entity_.get() == entity;
+  }
+
+  void on_entity_state_change(const std::string &state) override;
+  void on_entity_attribute_change(ha_attr_type attr, const std::string &value) override;
+
 protected:
+  std::shared_ptr<Entity> weather_entity_;
+  std::string temperature_unit_ = "°C";
+
   std::shared_ptr<StatusIconItem> left_icon;
   std::shared_ptr<StatusIconItem> right_icon;
 };
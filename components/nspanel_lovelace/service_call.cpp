@@ -0,0 +1,77 @@
+#include "service_call.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+namespace {
+
+void assign(api::HomeassistantServiceMap &kv,
+    const char *key, const char *value, size_t length) {
+  kv.key.assign(key);
+  kv.value.assign(value, length);
+}
+
+} // namespace
+
+ServiceCall &ServiceCall::add(ha_attr_type key, const char *value) {
+  return this->add_(key, value, std::strlen(value), false);
+}
+
+ServiceCall &ServiceCall::add_(ha_attr_type key,
+    const char *value, size_t length, bool is_template) {
+  // note: the calls are fixed in code so MAX_DATA is only exceeded if a new one is added,
+  //       release builds (NDEBUG) drop the value rather than writing past data_
+  assert(this->data_count_ < MAX_DATA);
+  if (this->data_count_ == MAX_DATA) return *this;
+  this->data_[this->data_count_++] = {to_string(key), value, length, is_template};
+  return *this;
+}
+
+std::string &ServiceCall::append_service(std::string &buffer) const {
+  return buffer.append(this->domain_).append(1, '.')
+    .append(this->action_prefix_).append(this->action_);
+}
+
+bool ServiceCall::is_service(const std::string &service) const {
+  const size_t domain_length = std::strlen(this->domain_);
+  const size_t prefix_length = std::strlen(this->action_prefix_);
+  const size_t action_length = std::strlen(this->action_);
+  return service.size() == domain_length + 1 + prefix_length + action_length &&
+    service.compare(0, domain_length, this->domain_) == 0 &&
+    service[domain_length] == '.' &&
+    service.compare(domain_length + 1, prefix_length, this->action_prefix_) == 0 &&
+    service.compare(domain_length + 1 + prefix_length, action_length, this->action_) == 0;
+}
+
+void ServiceCall::build(api::HomeassistantServiceResponse &resp) const {
+  resp.service.clear();
+  resp.service.reserve(std::strlen(this->domain_) + 1 +
+    std::strlen(this->action_prefix_) + std::strlen(this->action_));
+  this->append_service(resp.service);
+
+  uint8_t template_count = 0;
+  for (uint8_t i = 0; i < this->data_count_; i++) {
+    if (this->data_[i].is_template) template_count++;
+  }
+  // note: resized rather than cleared so the strings of a reused message
+  //       (e.g. a coalesced slot in ServiceCallQueue) keep their capacity
+  resp.data.resize(1 + this->data_count_ - template_count);
+  resp.data_template.resize(template_count);
+
+  assign(resp.data[0], to_string(ha_attr_type::entity_id),
+    this->entity_id_.data(), this->entity_id_.size());
+  uint8_t data_index = 1, template_index = 0;
+  for (uint8_t i = 0; i < this->data_count_; i++) {
+    auto &value = this->data_[i];
+    assign(value.is_template
+        ? resp.data_template[template_index++]
+        : resp.data[data_index++],
+      value.key, value.value, value.length);
+  }
+}
+
+} // namespace nspanel_lovelace
+} // namespace esphome
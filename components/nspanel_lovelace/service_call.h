@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <stdint.h>
+#include <string>
+
+#include "esphome/components/api/api_pb2.h"
+#include "types.h"
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+// Builds a HA service call (e.g. light.turn_on) without intermediate containers,
+// the strings are only copied once when the api message is built.
+// note: the values are referenced so they must outlive the builder
+class ServiceCall {
+public:
+  // The maximum number of data and data_template values (excluding the entity_id)
+  static constexpr uint8_t MAX_DATA = 3;
+
+  // {domain}.{action}
+  ServiceCall(const char *domain, const char *action, const std::string &entity_id) :
+      ServiceCall(domain, "", action, entity_id) {}
+  // {domain}.{action_prefix}{action} e.g. alarm_control_panel.alarm_arm_home
+  ServiceCall(const char *domain, const char *action_prefix,
+      const char *action, const std::string &entity_id) :
+      domain_(domain), action_prefix_(action_prefix),
+      action_(action), entity_id_(entity_id) {}
+
+  ServiceCall &add(ha_attr_type key, const std::string &value) {
+    return this->add_(key, value.data(), value.size(), false);
+  }
+  ServiceCall &add(ha_attr_type key, const char *value);
+  ServiceCall &add_template(ha_attr_type key, const std::string &value) {
+    return this->add_(key, value.data(), value.size(), true);
+  }
+  // Calls with the same entity, service and first value (e.g. brightness) can be
+  // replaced by newer ones before they are sent, see ServiceCallQueue
+  ServiceCall &coalesce() {
+    this->coalesce_ = true;
+    return *this;
+  }
+
+  const std::string &get_entity_id() const { return this->entity_id_; }
+  // The key of the first data value (e.g. brightness), nullptr if there are none
+  const char *get_param() const {
+    return this->data_count_ == 0 ? nullptr : this->data_[0].key;
+  }
+  bool is_coalesced() const { return this->coalesce_; }
+  bool is_service(const std::string &service) const;
+  // Appends {domain}.{action} to the buffer
+  std::string &append_service(std::string &buffer) const;
+  void build(api::HomeassistantServiceResponse &resp) const;
+
+protected:
+  struct Value {
+    const char *key;
+    const char *value;
+    size_t length;
+    bool is_template;
+  };
+
+  const char *domain_;
+  const char *action_prefix_;
+  const char *action_;
+  const std::string &entity_id_;
+  std::array<Value, MAX_DATA> data_;
+  uint8_t data_count_ = 0;
+  bool coalesce_ = false;
+
+  ServiceCall &add_(ha_attr_type key, const char *value, size_t length, bool is_template);
+};
+
+} // namespace nspanel_lovelace
+} // namespace esphome
@@ -0,0 +1,43 @@
+#include "service_call_queue.h"
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+void ServiceCallQueue::submit(const ServiceCall &call) {
+  this->calls_submitted_++;
+  Slot *target = nullptr;
+  for (auto &slot : this->slots_) {
+    if (slot.param == call.get_param() &&
+        slot.entity_id == call.get_entity_id() &&
+        call.is_service(slot.resp.service)) {
+      target = &slot;
+      break;
+    }
+  }
+  if (target == nullptr) {
+    this->slots_.emplace_back();
+    target = &this->slots_.back();
+    target->entity_id = call.get_entity_id();
+    target->param = call.get_param();
+  }
+  // note: a pending call is replaced, the message buffers are reused
+  call.build(target->resp);
+  target->pending = true;
+}
+
+void ServiceCallQueue::on_entity_update(const std::string &entity_id) {
+  for (auto &slot : this->slots_) {
+    if (slot.in_flight && slot.entity_id == entity_id) slot.in_flight = false;
+  }
+}
+
+uint32_t ServiceCallQueue::get_delay_(const Slot &slot, uint32_t now) const {
+  if (!slot.sent) return 0;
+  uint32_t wait = this->min_spacing_;
+  if (slot.in_flight && this->in_flight_timeout_ > wait) wait = this->in_flight_timeout_;
+  const uint32_t elapsed = now - slot.sent_at;
+  return elapsed >= wait ? 0 : wait - elapsed;
+}
+
+} // namespace nspanel_lovelace
+} // namespace esphome
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "esphome/components/api/api_pb2.h"
+#include "config.h"
+#include "service_call.h"
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+// Coalesces the service calls sent by high frequency controls (e.g. sliders) per
+// entity, service and parameter. A call is in flight until HA sends an update for
+// the entity (or the in flight timeout passes), while a call is in flight or within
+// the minimum spacing a newer call replaces the pending one. The latest call is
+// always sent so HA doesn't replay a backlog of values after a fast drag.
+class ServiceCallQueue {
+public:
+  void set_min_spacing(uint16_t spacing_ms) { this->min_spacing_ = spacing_ms; }
+  void set_in_flight_timeout(uint16_t timeout_ms) { this->in_flight_timeout_ = timeout_ms; }
+
+  // Holds the call as the pending call for its key, call flush() to send it
+  void submit(const ServiceCall &call);
+  // HA sent an update for the entity so the calls in flight have been applied
+  void on_entity_update(const std::string &entity_id);
+
+  // Calls fn(resp) for the pending calls which can be sent.
+  // Returns the time (ms) until the next pending call can be sent, 0 if none are pending.
+  template <typename F>
+  uint32_t flush(uint32_t now, F &&fn) {
+    uint32_t next_delay = 0;
+    for (auto it = this->slots_.begin(); it != this->slots_.end();) {
+      uint32_t delay = this->get_delay_(*it, now);
+      if (it->pending && delay == 0) {
+        this->send_(*it, now, fn);
+        ++it;
+        continue;
+      }
+      if (!it->pending) {
+        // idle slots are kept until they no longer delay the next call
+        if (delay == 0) {
+          it = this->slots_.erase(it);
+          continue;
+        }
+      } else if (next_delay == 0 || delay < next_delay) {
+        next_delay = delay;
+      }
+      ++it;
+    }
+    return next_delay;
+  }
+
+  // Calls fn(resp) for the pending calls of the entity without waiting. Used before
+  // a call which isn't coalesced (e.g. turn_off after a brightness drag), a pending
+  // call sent after it would undo it.
+  template <typename F>
+  void flush_entity(const std::string &entity_id, uint32_t now, F &&fn) {
+    for (auto &slot : this->slots_) {
+      if (slot.pending && slot.entity_id == entity_id) this->send_(slot, now, fn);
+    }
+  }
+
+  uint32_t get_calls_submitted() const { return this->calls_submitted_; }
+  uint32_t get_calls_sent() const { return this->calls_sent_; }
+
+protected:
+  struct Slot {
+    std::string entity_id;
+    const char *param;
+    // the pending (or last sent) call
+    api::HomeassistantServiceResponse resp;
+    uint32_t sent_at = 0;
+    bool sent = false;
+    bool in_flight = false;
+    bool pending = false;
+  };
+  std::vector<Slot> slots_;
+  uint16_t min_spacing_ = SERVICE_CALL_MIN_SPACING;
+  uint16_t in_flight_timeout_ = SERVICE_CALL_IN_FLIGHT_TIMEOUT;
+  uint32_t calls_submitted_ = 0;
+  uint32_t calls_sent_ = 0;
+
+  // The time (ms) until the slot can send another call
+  uint32_t get_delay_(const Slot &slot, uint32_t now) const;
+
+  template <typename F>
+  void send_(Slot &slot, uint32_t now, F &&fn) {
+    slot.pending = false;
+    slot.in_flight = true;
+    slot.sent = true;
+    slot.sent_at = now;
+    this->calls_sent_++;
+    fn(static_cast<const api::HomeassistantServiceResponse &>(slot.resp));
+  }
+};
+
+} // namespace nspanel_lovelace
+} // namespace esphome
@@ -0,0 +1,70 @@
+#include "string_pool.h"
+
+#include <memory>
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+StringPool *StringPool::instance() {
+  static std::unique_ptr<StringPool> pool;
+
+  if (pool == nullptr) pool.reset(new StringPool());
+  return pool.get();
+}
+
+StringPool::entry_type *StringPool::acquire(const std::string &value) {
+  auto p = StringPool::instance();
+  // note: unordered_map never moves its nodes so the entry pointer remains valid
+  auto &entry = *p->pool_.emplace(value, 0).first;
+  entry.second++;
+  p->ref_count_++;
+  return &entry;
+}
+
+StringPool::entry_type *StringPool::acquire(entry_type *entry) {
+  entry->second++;
+  StringPool::instance()->ref_count_++;
+  return entry;
+}
+
+void StringPool::release(entry_type *entry) {
+  auto p = StringPool::instance();
+  p->ref_count_--;
+  if (--entry->second > 0) return;
+  p->pool_.erase(p->pool_.find(entry->first));
+}
+
+size_t StringPool::get_size() { return StringPool::instance()->pool_.size(); }
+
+size_t StringPool::get_ref_count() { return StringPool::instance()->ref_count_; }
+
+size_t StringPool::get_entry_size_(const entry_type &entry) {
+  // short strings are stored inside the std::string object so only
+  // longer strings require a heap allocation
+  auto capacity = entry.first.capacity();
+  return sizeof(std::string) + (capacity > std::string().capacity() ? capacity + 1 : 0);
+}
+
+size_t StringPool::get_bytes_used() {
+  size_t bytes = 0;
+  for (auto &entry : StringPool::instance()->pool_) {
+    bytes += StringPool::get_entry_size_(entry);
+  }
+  return bytes;
+}
+
+size_t StringPool::get_bytes_saved() {
+  size_t bytes = 0;
+  for (auto &entry : StringPool::instance()->pool_) {
+    bytes += (entry.second - 1) * StringPool::get_entry_size_(entry);
+  }
+  return bytes;
+}
+
+const std::string &PooledString::str() const {
+  static const std::string empty_str;
+  return this->entry_ == nullptr ? empty_str : this->entry_->first;
+}
+
+} // namespace nspanel_lovelace
+} // namespace esphome
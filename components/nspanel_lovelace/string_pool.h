@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace esphome {
+namespace nspanel_lovelace {
+
+// A pool of immutable, reference counted strings. Identical values which are
+// held by many entities (e.g. the effect_list of identical bulbs) share one allocation.
+// note: Only used from the main loop so the reference counts are not atomic.
+class StringPool {
+public:
+  using entry_type = std::pair<const std::string, uint16_t>;
+
+  StringPool(StringPool const&) = delete;
+  void operator=(StringPool const&) = delete;
+  static StringPool *instance();
+
+  static entry_type *acquire(const std::string &value);
+  static entry_type *acquire(entry_type *entry);
+  static void release(entry_type *entry);
+
+  // The number of unique strings in the pool
+  static size_t get_size();
+  // The number of references to strings in the pool
+  static size_t get_ref_count();
+  // The heap bytes used by the pooled strings
+  static size_t get_bytes_used();
+  // The heap bytes which would be used if every reference held its own copy
+  static size_t get_bytes_saved();
+
+protected:
+  StringPool() {}
+
+  static size_t get_entry_size_(const entry_type &entry);
+
+  std::unordered_map<std::string, uint16_t> pool_;
+  size_t ref_count_ = 0;
+};
+
+// A handle to a string in the StringPool
+class PooledString {
+public:
+  PooledString() {}
+  explicit PooledString(const std::string &value) :
+      entry_(StringPool::acquire(value)) {}
+  PooledString(const PooledString &other) :
+      entry_(other.entry_ == nullptr ? nullptr : StringPool::acquire(other.entry_)) {}
+  PooledString(PooledString &&other) noexcept : entry_(other.entry_) {
+    other.entry_ = nullptr;
+  }
+  PooledString &operator=(PooledString other) noexcept {
+    std::swap(this->entry_, other.entry_);
+    return *this;
+  }
+  ~PooledString() {
+    if (this->entry_ != nullptr) StringPool::release(this->entry_);
+  }
+
+  const std::string &str() const;
+  bool empty() const { return this->entry_ == nullptr || this->entry_->first.empty(); }
+
+protected:
+  StringPool::entry_type *entry_ = nullptr;
+};
+
+} // namespace nspanel_lovelace
+} // namespace esphome
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <stdint.h>
 #include <string>
 #include <utility>
@@ -693,9 +694,147 @@ inline datetime_mode operator&(datetime_mode a, datetime_mode b) {
 }
 
 // note: The FrozenCharMap is designed to avoid dynamic memory allocation by
-//       making use of std::array instead of std::map
+//       making use of std::array instead of std::map.
+//       Maps are sorted by key at compile time (see make_frozen_map) so
+//       lookups can use a binary search. The entries are constexpr which
+//       means the map is stored in flash (rodata) and not copied to RAM.
+template <typename Value>
+struct FrozenCharMapItem {
+  const char *first;
+  Value second;
+};
+
+template <typename Value, size_t Size>
+using FrozenCharMap = const std::array<FrozenCharMapItem<Value>, Size>;
+
+// strcmp which can be used in constant expressions
+inline constexpr int str_compare(const char *a, const char *b) {
+  while (*a != '\0' && *a == *b) {
+    ++a;
+    ++b;
+  }
+  return static_cast<int>(static_cast<unsigned char>(*a)) -
+      static_cast<int>(static_cast<unsigned char>(*b));
+}
+
+// Sorts the map items by key so they can be used with find_value().
+// note: This is a stable insertion sort so when duplicate keys exist
+//       the first key in the initialiser list will be found first.
+template <typename Value, size_t Size>
+inline constexpr std::array<FrozenCharMapItem<Value>, Size> make_frozen_map(
+    std::array<FrozenCharMapItem<Value>, Size> items) {
+  for (size_t i = 1; i < Size; i++) {
+    auto item = items[i];
+    size_t j = i;
+    for (; j > 0 && str_compare(items[j - 1].first, item.first) > 0; j--) {
+      items[j] = items[j - 1];
+    }
+    items[j] = item;
+  }
+  return items;
+}
+
+// find_value() requires the keys to be sorted, each map is checked with a static_assert
 template <typename Value, size_t Size>
-using FrozenCharMap = const std::array<std::pair<const char *, Value>, Size>;
+inline constexpr bool is_frozen_map_sorted(const FrozenCharMap<Value, Size> &map) {
+  for (size_t i = 1; i < Size; i++) {
+    if (str_compare(map[i - 1].first, map[i].first) > 0) return false;
+  }
+  return true;
+}
+
+// Returns a pointer to the value stored in the map (or nullptr if not found)
+template<typename Value, size_t Size>
+inline const Value *find_value(
+    const FrozenCharMap<Value, Size> &map, const char *key) {
+  if (Size == 0 || key == nullptr || key[0] == '\0')
+    return nullptr;
+
+  size_t low = 0, high = Size;
+  while (low < high) {
+    size_t mid = low + ((high - low) >> 1);
+    if (str_compare(map[mid].first, key) < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  if (low < Size && str_compare(map[low].first, key) == 0)
+    return &map[low].second;
+  return nullptr;
+}
+
+template<typename Value, size_t Size>
+inline const Value *find_value(
+    const FrozenCharMap<Value, Size> &map,
+    const char *key,
+    const char *fallback_key) {
+  auto ret = find_value(map, key);
+  if (ret != nullptr || key == fallback_key) return ret;
+  return find_value(map, fallback_key);
+}
+
+// The items of a map whose keys start with the same prefix (e.g. 'binary_sensor.'),
+// because the map is sorted these items are always next to each other.
+template <typename Value>
+struct FrozenCharMapRange {
+  const FrozenCharMapItem<Value> *begin = nullptr;
+  const FrozenCharMapItem<Value> *end = nullptr;
+  size_t prefix_length = 0;
+
+  bool empty() const { return begin == end; }
+};
+
+template<typename Value, size_t Size>
+inline FrozenCharMapRange<Value> find_prefix_range(
+    const FrozenCharMap<Value, Size> &map, const std::string &prefix) {
+  FrozenCharMapRange<Value> range;
+  range.prefix_length = prefix.length();
+  if (Size == 0 || prefix.empty()) return range;
+
+  auto compare_prefix = [&prefix](const char *key) {
+    return std::strncmp(key, prefix.c_str(), prefix.length());
+  };
+  size_t low = 0, high = Size;
+  while (low < high) {
+    size_t mid = low + ((high - low) >> 1);
+    if (compare_prefix(map[mid].first) < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  size_t first = low;
+  high = Size;
+  while (low < high) {
+    size_t mid = low + ((high - low) >> 1);
+    if (compare_prefix(map[mid].first) <= 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  range.begin = map.data() + first;
+  range.end = map.data() + low;
+  return range;
+}
+
+// Returns a pointer to the value whose key (without the prefix) matches, or nullptr
+template<typename Value>
+inline const Value *find_value(
+    const FrozenCharMapRange<Value> &range, const char *key) {
+  if (range.empty() || key == nullptr || key[0] == '\0')
+    return nullptr;
+
+  auto low = range.begin, high = range.end;
+  while (low < high) {
+    auto mid = low + ((high - low) >> 1);
+    if (str_compare(mid->first + range.prefix_length, key) < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  if (low < range.end && str_compare(low->first + range.prefix_length, key) == 0)
+    return &low->second;
+  return nullptr;
+}
 
 template<typename Value, size_t Size>
 inline bool try_get_value(
@@ -703,26 +842,10 @@ inline bool try_get_value(
     Value &return_value,
     const char *key,
     const char *fallback_key = nullptr) {
-  if (map.size() == 0)
-    return false;
-
-  const char *key_cstr = key;
-  do {
-    if ((key_cstr != nullptr && strlen(key_cstr) > 0)) {
-      auto it = map.begin();
-      for (; it != map.end(); ++it) {
-        if (!str_equal(it->first, key_cstr)) continue;
-        return_value = it->second;
-        return true;
-      }
-    }
-    if (key_cstr == fallback_key || 
-        fallback_key == nullptr || strlen(fallback_key) == 0)
-      return false;
-    key_cstr = fallback_key;
-  } while (true);
-
-  return false;
+  auto ret = find_value(map, key, fallback_key);
+  if (ret == nullptr) return false;
+  return_value = *ret;
+  return true;
 }
 
 template<typename Value, size_t Size>
@@ -734,18 +857,23 @@ inline bool try_get_value(
   return try_get_value(map, return_value, key.c_str(), fallback_key);
 }
 
+template<typename Value, size_t Size>
+inline const Value &get_value_or_default(
+    const FrozenCharMap<Value, Size> &map,
+    const char *key,
+    const Value &default_value,
+    const char *fallback_key = nullptr) {
+  auto ret = find_value(map, key, fallback_key);
+  return ret == nullptr ? default_value : *ret;
+}
+
 template<typename Value, size_t Size>
 inline const Value &get_value_or_default(
     const FrozenCharMap<Value, Size> &map,
     const std::string &key,
     const Value &default_value,
     const char *fallback_key = nullptr) {
-  // todo: fix this bad implementation
-  //       use pointers and unwrap Value?
-  static Value ret{};
-  if (try_get_value(map, ret, key.c_str(), fallback_key))
-    return ret;
-  return default_value;
+  return get_value_or_default(map, key.c_str(), default_value, fallback_key);
 }
 
 template<size_t Size>
@@ -753,11 +881,12 @@ inline const char *get_icon(
     const FrozenCharMap<const char *, Size> &map,
     const std::string &key,
     const char *fallback_key = nullptr) {
-  return get_value_or_default(map, key, icon_t::alert_circle_outline, fallback_key);
+  return get_value_or_default(map, key.c_str(),
+      static_cast<const char *>(icon_t::alert_circle_outline), fallback_key);
 }
 
 // simple_type_mapping
-static constexpr FrozenCharMap<const char *, 22> ENTITY_ICON_MAP {{
+static constexpr FrozenCharMap<const char *, 22> ENTITY_ICON_MAP = make_frozen_map<const char *, 22>({{
   {entity_type::button, icon_t::gesture_tap_button},
   {entity_type::navigate, icon_t::gesture_tap_button},
   {entity_type::input_button, icon_t::gesture_tap_button},
@@ -781,10 +910,11 @@ static constexpr FrozenCharMap<const char *, 22> ENTITY_ICON_MAP {{
   {entity_type::input_text, icon_t::cursor_text}, //added
   {entity_type::text, icon_t::cursor_text}, //added
   {entity_type::select, icon_t::gesture_tap_button}, //added
-}};
+}});
+static_assert(is_frozen_map_sorted(ENTITY_ICON_MAP), "ENTITY_ICON_MAP must be built with make_frozen_map");
 
 // sensor_mapping_on
-static constexpr FrozenCharMap<const char *, 27> SENSOR_ON_ICON_MAP {{
+static constexpr FrozenCharMap<const char *, 27> SENSOR_ON_ICON_MAP = make_frozen_map<const char *, 27>({{
   {sensor_type::battery, icon_t::battery_outline},
   {sensor_type::battery_charging, icon_t::battery_charging},
   {sensor_type::carbon_monoxide, icon_t::smoke_detector_alert},
@@ -812,10 +942,11 @@ static constexpr FrozenCharMap<const char *, 27> SENSOR_ON_ICON_MAP {{
   {sensor_type::update, icon_t::package_up},
   {sensor_type::vibration, icon_t::vibrate},
   {sensor_type::window, icon_t::window_open}
-}};
+}});
+static_assert(is_frozen_map_sorted(SENSOR_ON_ICON_MAP), "SENSOR_ON_ICON_MAP must be built with make_frozen_map");
 
 // sensor_mapping_off
-static constexpr FrozenCharMap<const char *, 27> SENSOR_OFF_ICON_MAP {{
+static constexpr FrozenCharMap<const char *, 27> SENSOR_OFF_ICON_MAP = make_frozen_map<const char *, 27>({{
   {sensor_type::battery, icon_t::battery},
   {sensor_type::battery_charging, icon_t::battery},
   {sensor_type::carbon_monoxide, icon_t::smoke_detector},
@@ -843,10 +974,11 @@ static constexpr FrozenCharMap<const char *, 27> SENSOR_OFF_ICON_MAP {{
   {sensor_type::update, icon_t::package},
   {sensor_type::vibration, icon_t::crop_portrait},
   {sensor_type::window, icon_t::window_closed},
-}};
+}});
+static_assert(is_frozen_map_sorted(SENSOR_OFF_ICON_MAP), "SENSOR_OFF_ICON_MAP must be built with make_frozen_map");
 
 // sensor_mapping
-static constexpr FrozenCharMap<const char *, 31> SENSOR_ICON_MAP {{
+static constexpr FrozenCharMap<const char *, 31> SENSOR_ICON_MAP = make_frozen_map<const char *, 31>({{
   {sensor_type::apparent_power, icon_t::flash},
   {sensor_type::aqi, icon_t::smog},
   {sensor_type::battery, icon_t::battery},
@@ -878,7 +1010,8 @@ static constexpr FrozenCharMap<const char *, 31> SENSOR_ICON_MAP {{
   {sensor_type::timestamp, icon_t::calendar_clock},
   {sensor_type::volatile_organic_compounds, icon_t::smog},
   {sensor_type::voltage, icon_t::flash}
-}};
+}});
+static_assert(is_frozen_map_sorted(SENSOR_ICON_MAP), "SENSOR_ICON_MAP must be built with make_frozen_map");
 
 // A map of icons and their respective color for each weather condition
 // see:
@@ -892,7 +1025,7 @@ static constexpr FrozenCharMap<const char *, 31> SENSOR_ICON_MAP {{
 //      - mdi icons: https://pictogrammers.com/library/mdi/
 //  - color lookup:
 //      - https://rgbcolorpicker.com/565
-static constexpr FrozenCharMap<Icon, 15> WEATHER_ICON_MAP {{
+static constexpr FrozenCharMap<Icon, 15> WEATHER_ICON_MAP = make_frozen_map<Icon, 15>({{
   {weather_type::sunny,           {icon_t::weather_sunny, 65504u}}, // mdi:0599,#ffff00
   {weather_type::windy,           {icon_t::weather_windy, 38066u}}, // mdi:059D,#949694
   {weather_type::windy_variant,   {icon_t::weather_windy_variant, 64495u}}, // mdi:059E,#ff7d7b
@@ -908,10 +1041,11 @@ static constexpr FrozenCharMap<Icon, 15> WEATHER_ICON_MAP {{
   {weather_type::hail,            {icon_t::weather_hail, 65535u}}, // mdi:0592,#ffffff
   {weather_type::lightning,       {icon_t::weather_lightning, 65120u}}, // mdi:0593,#ffce00
   {weather_type::lightning_rainy, {icon_t::weather_lightning_rainy, 50400u}} // mdi:067E,#c59e00
-}};
+}});
+static_assert(is_frozen_map_sorted(WEATHER_ICON_MAP), "WEATHER_ICON_MAP must be built with make_frozen_map");
 
 // climate_mapping
-static constexpr FrozenCharMap<const char *, 7> CLIMATE_ICON_MAP {{
+static constexpr FrozenCharMap<const char *, 7> CLIMATE_ICON_MAP = make_frozen_map<const char *, 7>({{
   {entity_state::auto_, icon_t::calendar_sync},
   {entity_state::heat_cool, icon_t::calendar_sync},
   {entity_state::heat, icon_t::fire},
@@ -919,9 +1053,10 @@ static constexpr FrozenCharMap<const char *, 7> CLIMATE_ICON_MAP {{
   {entity_state::cool, icon_t::snowflake},
   {entity_state::dry, icon_t::water_percent},
   {entity_state::fan_only, icon_t::fan},
-}};
+}});
+static_assert(is_frozen_map_sorted(CLIMATE_ICON_MAP), "CLIMATE_ICON_MAP must be built with make_frozen_map");
 
-static constexpr FrozenCharMap<const char *, 9> MEDIA_TYPE_ICON_MAP {{
+static constexpr FrozenCharMap<const char *, 9> MEDIA_TYPE_ICON_MAP = make_frozen_map<const char *, 9>({{
   {entity_state::off, icon_t::speaker_off},
   {ha_attr_media_content_type::music, icon_t::music},
   {ha_attr_media_content_type::tvshow, icon_t::movie},
@@ -931,9 +1066,10 @@ static constexpr FrozenCharMap<const char *, 9> MEDIA_TYPE_ICON_MAP {{
   {ha_attr_media_content_type::playlist, icon_t::playlist_music}, // (originally: icon_t::alert_circle_outline)
   {ha_attr_media_content_type::app, icon_t::open_in_app}, // newly added!
   {ha_attr_media_content_type::url, icon_t::link_box_outline}, // newly added! (OR cast E117?)
-}};
+}});
+static_assert(is_frozen_map_sorted(MEDIA_TYPE_ICON_MAP), "MEDIA_TYPE_ICON_MAP must be built with make_frozen_map");
 
-const FrozenCharMap<Icon, 10> ALARM_ICON_MAP {{
+static constexpr FrozenCharMap<Icon, 10> ALARM_ICON_MAP = make_frozen_map<Icon, 10>({{
   {entity_state::unknown, {icon_t::shield_off, 0x0CE6u}}, //green
   {entity_state::disarmed, {icon_t::shield_off, 0x0CE6u}}, //green
   {entity_state::armed_home, {icon_t::shield_home, 0xE243u}}, //red
@@ -944,10 +1080,11 @@ const FrozenCharMap<Icon, 10> ALARM_ICON_MAP {{
   {entity_state::arming, {icon_t::shield, 0xED80u}}, //orange
   {entity_state::pending, {icon_t::shield, 0xED80u}}, //orange
   {entity_state::triggered, {icon_t::bell_ring, 0xE243u}}, //red
-}};
+}});
+static_assert(is_frozen_map_sorted(ALARM_ICON_MAP), "ALARM_ICON_MAP must be built with make_frozen_map");
 
 // cover_mapping
-static constexpr FrozenCharMap<std::array<const char *, 4>, 10> COVER_MAP {{
+static constexpr FrozenCharMap<std::array<const char *, 4>, 10> COVER_MAP = make_frozen_map<std::array<const char *, 4>, 10>({{
   // "device_class": ("icon-open", "icon-closed", "icon-cover-open", "icon-cover-close")
   {entity_cover_type::awning, {icon_t::window_open, icon_t::window_closed, icon_t::arrow_up, icon_t::arrow_down}},
   {entity_cover_type::blind, {icon_t::blinds_open, icon_t::blinds, icon_t::arrow_up, icon_t::arrow_down}},
@@ -959,9 +1096,10 @@ static constexpr FrozenCharMap<std::array<const char *, 4>, 10> COVER_MAP {{
   {entity_cover_type::shade, {icon_t::blinds_open, icon_t::blinds, icon_t::arrow_up, icon_t::arrow_down}},
   {entity_cover_type::shutter, {icon_t::window_shutter_open, icon_t::window_shutter, icon_t::arrow_up, icon_t::arrow_down}},
   {entity_cover_type::window, {icon_t::window_open, icon_t::window_closed, icon_t::arrow_up, icon_t::arrow_down}},
-}};
+}});
+static_assert(is_frozen_map_sorted(COVER_MAP), "COVER_MAP must be built with make_frozen_map");
 
-static constexpr FrozenCharMap<const char *, 29> ENTITY_RENDER_TYPE_MAP {{
+static constexpr FrozenCharMap<const char *, 29> ENTITY_RENDER_TYPE_MAP = make_frozen_map<const char *, 29>({{
   {entity_type::cover, entity_render_type::shutter},
   {entity_type::light, entity_type::light},
 
@@ -998,7 +1136,8 @@ static constexpr FrozenCharMap<const char *, 29> ENTITY_RENDER_TYPE_MAP {{
 
   {entity_type::timer, entity_type::timer},
   {entity_type::media_player, entity_render_type::media_pl},
-}};
+}});
+static_assert(is_frozen_map_sorted(ENTITY_RENDER_TYPE_MAP), "ENTITY_RENDER_TYPE_MAP must be built with make_frozen_map");
 
 inline const char *get_entity_type(const std::string &entity_id) {
   auto pos = entity_id.find('.');
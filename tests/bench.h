@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// A minimal benchmark harness, the results are printed as ns per call
+
+// Keeps the compiler from optimising away a result
+template <typename T>
+inline void do_not_optimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// The average time (ns) of fn() over the iterations
+template <typename F>
+inline double bench_ns(unsigned long iterations, F &&fn) {
+  // warm up
+  for (unsigned long i = 0; i < iterations / 10 + 1; i++) fn();
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < iterations; i++) fn();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
@@ -0,0 +1,33 @@
+// xy_to_rgb on a recorded style colour wheel drag (a circle around the wheel with
+// a changing radius, as sent while dragging) compared with the double version
+#include "helpers.h"
+#include "color_reference.h"
+#include "bench.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace esphome::nspanel_lovelace;
+
+int main() {
+  struct Point { int x, y; };
+  std::vector<Point> drag;
+  for (int i = 0; i < 1000; i++) {
+    const double angle = i * 2 * M_PI / 250;
+    const double radius = 20 + 55 * std::fabs(std::sin(i / 90.0));
+    drag.push_back({static_cast<int>(80 + radius * std::cos(angle)), static_cast<int>(80 + radius * std::sin(angle))});
+  }
+  size_t index = 0;
+  const double single = bench_ns(1000000, [&]() {
+    do_not_optimize(xy_to_rgb(drag[index].x, drag[index].y, 160));
+    if (++index == drag.size()) index = 0;
+  });
+  index = 0;
+  const double reference = bench_ns(1000000, [&]() {
+    do_not_optimize(reference_xy_to_rgb(drag[index].x, drag[index].y, 160));
+    if (++index == drag.size()) index = 0;
+  });
+  std::printf("xy_to_rgb (%zu point drag): float %5.1f ns  double %5.1f ns\n", drag.size(), single, reference);
+  std::printf("note: the host has a double precision FPU, on the ESP32 doubles are emulated in software\n");
+  return 0;
+}
@@ -0,0 +1,48 @@
+// WeatherForecast::update on hourly and daily forecasts in the layouts HA sends,
+// with the heap allocations made while parsing (the entries are kept in place)
+#include "forecast.h"
+#include "forecast_data.h"
+#include "bench.h"
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace esphome::nspanel_lovelace;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  if (void *ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+void bench_update(const char *name, const std::string &data) {
+  WeatherForecast forecast;
+  const size_t before = allocations;
+  forecast.update(data.data(), data.size());
+  const size_t parse_allocations = allocations - before;
+  const double ns = bench_ns(20000, [&]() {
+    forecast.update(data.data(), data.size());
+    do_not_optimize(forecast.size());
+  });
+  std::printf("%-22s %6zu bytes  entries:%u  %8.0f ns  heap allocations:%zu\n",
+    name, data.size(), forecast.size(), ns, parse_allocations);
+}
+
+} // namespace
+
+int main() {
+  std::printf("WeatherForecast: %zu bytes (%u entries of %zu bytes)\n",
+    sizeof(WeatherForecast), WeatherForecast::MAX_ENTRIES, sizeof(ForecastEntry));
+  bench_update("hourly (48, python)", make_hourly_forecast(48));
+  bench_update("hourly (48, json)", make_hourly_forecast(48, true));
+  bench_update("daily (7, python)", make_daily_forecast(7));
+  bench_update("daily (7, json)", make_daily_forecast(7, true));
+  return 0;
+}
@@ -0,0 +1,55 @@
+// find_value (binary search) compared with a linear scan for each map size,
+// the lookups cycle through all keys of the map plus the same number of misses
+#include "types.h"
+#include "bench.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+template <typename Value, size_t Size>
+const Value *find_value_linear(const FrozenCharMap<Value, Size> &map, const char *key) {
+  for (auto &item : map) {
+    if (std::strcmp(item.first, key) == 0) return &item.second;
+  }
+  return nullptr;
+}
+
+template <typename Value, size_t Size>
+void bench_map(const char *name, const FrozenCharMap<Value, Size> &map) {
+  // copies so the keys aren't compared by pointer
+  std::vector<std::string> keys;
+  for (auto &item : map) {
+    keys.emplace_back(item.first);
+    keys.emplace_back(std::string(item.first) + "_missing");
+  }
+  size_t index = 0;
+  const double binary = bench_ns(1000000, [&]() {
+    do_not_optimize(find_value(map, keys[index].c_str()));
+    if (++index == keys.size()) index = 0;
+  });
+  index = 0;
+  const double linear = bench_ns(1000000, [&]() {
+    do_not_optimize(find_value_linear(map, keys[index].c_str()));
+    if (++index == keys.size()) index = 0;
+  });
+  std::printf("%-24s size:%3zu  binary:%6.1f ns  linear:%6.1f ns\n", name, Size, binary, linear);
+}
+
+} // namespace
+
+int main() {
+  bench_map("CLIMATE_ICON_MAP", CLIMATE_ICON_MAP);
+  bench_map("MEDIA_TYPE_ICON_MAP", MEDIA_TYPE_ICON_MAP);
+  bench_map("COVER_MAP", COVER_MAP);
+  bench_map("WEATHER_ICON_MAP", WEATHER_ICON_MAP);
+  bench_map("ENTITY_ICON_MAP", ENTITY_ICON_MAP);
+  bench_map("SENSOR_ON_ICON_MAP", SENSOR_ON_ICON_MAP);
+  bench_map("ENTITY_RENDER_TYPE_MAP", ENTITY_RENDER_TYPE_MAP);
+  bench_map("SENSOR_ICON_MAP", SENSOR_ICON_MAP);
+  return 0;
+}
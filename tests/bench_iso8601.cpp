@@ -0,0 +1,73 @@
+// iso8601_to_epoch compared with the previous sscanf + mktime implementation
+// (iso8601_to_tm), run with TZ=UTC as the previous version depended on the TZ
+#include "helpers.h"
+#include "bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <time.h>
+#include <vector>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+// the previous implementation, the offset is ignored
+bool previous_iso8601_to_tm(const char *iso8601_string, tm &t) {
+  if (iso8601_string == nullptr) return false;
+  static constexpr const char *format = "%d-%d-%dT%d:%d:%d";
+  uint8_t parse_count = std::sscanf(iso8601_string, format,
+    &t.tm_year, &t.tm_mon, &t.tm_mday, &t.tm_hour, &t.tm_min, &t.tm_sec);
+  if (parse_count < 3) return false;
+  t.tm_year -= 1900;
+  t.tm_mon -= 1;
+  const time_t time_temp = mktime(&t);
+  if (time_temp == -1) return false;
+  t = *gmtime(&time_temp);
+  return true;
+}
+
+time_t previous_iso8601_to_epoch(const char *str) {
+  tm t{};
+  if (!previous_iso8601_to_tm(str, t)) return -1;
+  return mktime(&t);
+}
+
+} // namespace
+
+int main() {
+  setenv("TZ", "UTC", 1);
+  tzset();
+
+  std::vector<std::string> timestamps;
+  for (int i = 0; i < 1000; i++) {
+    const time_t epoch = 1692738000 + i * 3607;
+    tm t;
+    gmtime_r(&epoch, &t);
+    char str[32];
+    std::strftime(str, sizeof(str), "%Y-%m-%dT%H:%M:%S+00:00", &t);
+    timestamps.emplace_back(str);
+  }
+  int differences = 0;
+  for (auto &str : timestamps) {
+    time_t epoch;
+    if (!iso8601_to_epoch(str.c_str(), epoch) || epoch != previous_iso8601_to_epoch(str.c_str())) differences++;
+  }
+
+  size_t index = 0;
+  const double current = bench_ns(200000, [&]() {
+    time_t epoch;
+    do_not_optimize(iso8601_to_epoch(timestamps[index].c_str(), epoch));
+    do_not_optimize(epoch);
+    if (++index == timestamps.size()) index = 0;
+  });
+  index = 0;
+  const double previous = bench_ns(200000, [&]() {
+    do_not_optimize(previous_iso8601_to_epoch(timestamps[index].c_str()));
+    if (++index == timestamps.size()) index = 0;
+  });
+  std::printf("iso8601_to_epoch: %6.1f ns  previous (sscanf + mktime): %6.1f ns  differences: %d/%zu\n",
+    current, previous, differences, timestamps.size());
+  return differences == 0 ? 0 : 1;
+}
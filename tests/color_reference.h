@@ -0,0 +1,37 @@
+#pragma once
+// The double precision colour wheel conversion the float version replaced, with the
+// hue wrapped with floor and the position multiplied before dividing (as in helpers.h)
+// so the results only differ by the precision
+
+#include <array>
+#include <cmath>
+#include <stdint.h>
+
+inline std::array<uint8_t, 3> reference_hsv2rgb(double h, double s, double v) {
+  if (s <= 0.0) {
+    auto val = static_cast<uint8_t>(std::round(v * 255));
+    return {val, val, val};
+  }
+  const double h6 = (h - std::floor(h)) * 6.0;
+  const auto i = static_cast<uint32_t>(h6);
+  const double f = h6 - i, p = v * (1.0 - s), q = v * (1.0 - (s * f)), t = v * (1.0 - (s * (1.0 - f)));
+  double r, g, b;
+  switch (i) {
+    case 0: r = v, g = t, b = p; break;
+    case 1: r = q, g = v, b = p; break;
+    case 2: r = p, g = v, b = t; break;
+    case 3: r = p, g = q, b = v; break;
+    case 4: r = t, g = p, b = v; break;
+    default: r = v, g = p, b = q; break;
+  }
+  return {static_cast<uint8_t>(std::round(r * 255)), static_cast<uint8_t>(std::round(g * 255)),
+    static_cast<uint8_t>(std::round(b * 255))};
+}
+
+inline std::array<uint8_t, 3> reference_xy_to_rgb(double x, double y, double wh) {
+  const double r = wh / 2;
+  x = std::round((x - r) * 100 / r) / 100;
+  y = std::round((r - y) * 100 / r) / 100;
+  const double saturation = std::sqrt((x * x) + (y * y));
+  return reference_hsv2rgb(std::atan2(y, x) / (2 * M_PI), saturation > 1 ? 0 : saturation, 1);
+}
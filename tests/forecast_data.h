@@ -0,0 +1,50 @@
+#pragma once
+// Forecast attributes in the layouts HA sends them, shared by the forecast test and benchmark
+
+#include <cstdio>
+#include <string>
+
+// An hourly forecast starting at 2023-08-22T21:00:00+00:00, python formatted
+// (e.g. [{'condition': 'cloudy', 'datetime': '...', ...}]) unless json is set
+inline std::string make_hourly_forecast(int count, bool json = false) {
+  static const char *CONDITIONS[] = {"cloudy", "partlycloudy", "rainy", "clear-night", "sunny"};
+  std::string data = "[";
+  for (int i = 0; i < count; i++) {
+    const int hour = 21 + i;
+    char entry[320];
+    std::snprintf(entry, sizeof(entry),
+      "%s{'condition': '%s', 'datetime': '2023-08-%02dT%02d:00:00+00:00', 'wind_bearing': 239.4, "
+      "'cloud_coverage': 89.1, 'temperature': %.1f, 'wind_speed': 14.0, 'precipitation': 0.0, "
+      "'humidity': %d}",
+      i == 0 ? "" : ", ", CONDITIONS[i % 5], 22 + hour / 24, hour % 24, 16.4 - i * 0.1, 60 + i % 30);
+    data += entry;
+  }
+  data += "]";
+  if (json) {
+    for (auto &c : data) {
+      if (c == '\'') c = '"';
+    }
+  }
+  return data;
+}
+
+// A daily forecast starting at 2023-08-22T10:00:00+02:00 with a templow and a
+// None temperature for the last day, python formatted unless json is set
+inline std::string make_daily_forecast(int count, bool json = false) {
+  std::string data = "[";
+  for (int i = 0; i < count; i++) {
+    char entry[320];
+    std::snprintf(entry, sizeof(entry),
+      "%s{'datetime': '2023-08-%02dT10:00:00+02:00', 'condition': 'rainy', 'precipitation_probability': 40, "
+      "'wind_bearing': 200, 'temperature': %s, 'templow': 12.0, 'wind_speed': 9.4, 'precipitation': 1.2}",
+      i == 0 ? "" : ", ", 22 + i, i == count - 1 ? (json ? "null" : "None") : "21.5");
+    data += entry;
+  }
+  data += "]";
+  if (json) {
+    for (auto &c : data) {
+      if (c == '\'') c = '"';
+    }
+  }
+  return data;
+}
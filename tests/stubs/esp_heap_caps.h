@@ -0,0 +1,7 @@
+#pragma once
+// host stub for the esp-idf heap functions used by helpers.h
+#include <cstddef>
+
+#define MALLOC_CAP_SPIRAM 0
+inline size_t heap_caps_get_total_size(int) { return 0; }
+inline size_t heap_caps_get_free_size(int) { return 0; }
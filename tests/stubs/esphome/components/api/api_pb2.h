@@ -0,0 +1,30 @@
+#pragma once
+// host stub for the ESPHome api messages used by ServiceCall/ServiceCallQueue
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace api {
+
+class ProtoMessage {
+public:
+  virtual ~ProtoMessage() = default;
+};
+
+class HomeassistantServiceMap : public ProtoMessage {
+public:
+  std::string key{};
+  std::string value{};
+};
+
+class HomeassistantServiceResponse : public ProtoMessage {
+public:
+  std::string service{};
+  std::vector<HomeassistantServiceMap> data{};
+  std::vector<HomeassistantServiceMap> data_template{};
+  std::vector<HomeassistantServiceMap> variables{};
+  bool is_event{false};
+};
+
+} // namespace api
+} // namespace esphome
@@ -0,0 +1,10 @@
+#pragma once
+// host stub for the ESPHome hal, tests set the time returned by millis()
+#include <stdint.h>
+
+namespace esphome {
+
+inline uint32_t host_millis = 0;
+inline uint32_t millis() { return host_millis; }
+
+} // namespace esphome
@@ -0,0 +1,11 @@
+#pragma once
+// host stub for the ESPHome helpers used by the component
+#include <string>
+
+namespace esphome {
+
+inline bool str_startswith(const std::string &str, const std::string &start) {
+  return str.rfind(start, 0) == 0;
+}
+
+} // namespace esphome
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+// A minimal test harness, each test is a program which returns non-zero on failure
+
+static int test_failures = 0;
+
+#define CHECK(cond)                                                                  \
+  do {                                                                               \
+    if (!(cond)) {                                                                   \
+      if (test_failures++ < 20)                                                      \
+        std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+    }                                                                                \
+  } while (0)
+
+inline int test_result(const char *name) {
+  if (test_failures != 0) {
+    std::fprintf(stderr, "%s: %d failures\n", name, test_failures);
+    return 1;
+  }
+  std::printf("%s: ok\n", name);
+  return 0;
+}
+
+// The number of random cases fuzz tests run, set with the FUZZ_ITERATIONS environment variable
+inline unsigned long fuzz_iterations(unsigned long default_iterations) {
+  const char *env = std::getenv("FUZZ_ITERATIONS");
+  if (env == nullptr || *env == '\0') return default_iterations;
+  return std::strtoul(env, nullptr, 10);
+}
@@ -0,0 +1,84 @@
+// hsv2rgb/xy_to_rgb compared with the double precision versions on every colour
+// wheel position, plus invalid input from the TFT (see helpers.h)
+#include "helpers.h"
+#include "color_reference.h"
+#include "test.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+using rgb = std::array<uint8_t, 3>;
+
+void test_wheel() {
+  // the TFT wheel is 160x160, the positions include both edges
+  int max_difference = 0, differences = 0;
+  for (int x = 0; x <= 160; x++) {
+    for (int y = 0; y <= 160; y++) {
+      const auto value = xy_to_rgb(x, y, 160);
+      const auto expected = reference_xy_to_rgb(x, y, 160);
+      for (int c = 0; c < 3; c++) {
+        const int difference = std::abs(value[c] - expected[c]);
+        if (difference > max_difference) max_difference = difference;
+        if (difference != 0) differences++;
+      }
+    }
+  }
+  // float rounding moves a few values by one
+  CHECK(max_difference <= 1);
+  CHECK(differences <= 10);
+
+  CHECK((xy_to_rgb(80, 80, 160) == rgb{255, 255, 255}));
+  CHECK((xy_to_rgb(160, 80, 160) == rgb{255, 0, 0}));
+  CHECK((xy_to_rgb(80, 0, 160) == reference_xy_to_rgb(80, 0, 160)));
+  // outside the wheel is white
+  CHECK((xy_to_rgb(0, 0, 160) == rgb{255, 255, 255}));
+}
+
+void test_invalid() {
+  // e.g. 0|0|0 from the TFT, 0 / 0 would be NaN
+  CHECK((xy_to_rgb(0, 0, 0) == rgb{255, 255, 255}));
+  CHECK((xy_to_rgb(10, 10, -160) == rgb{255, 255, 255}));
+  CHECK((xy_to_rgb(NAN, 10, 160) == rgb{255, 255, 255}));
+  CHECK((xy_to_rgb(10, INFINITY, 160) == rgb{255, 255, 255}));
+  CHECK((xy_to_rgb(10, 10, NAN) == rgb{255, 255, 255}));
+  // very large values don't overflow into NaN
+  CHECK((xy_to_rgb(3e38f, 0, 1e-30f) == rgb{255, 255, 255}));
+  CHECK((xy_to_rgb(0, 3e38f, 3e38f) == reference_xy_to_rgb(0, 3e38f, 3e38f)));
+
+  CHECK((hsv2rgb(NAN, 1, 1) == rgb{255, 0, 0}));
+  CHECK((hsv2rgb(INFINITY, 1, 1) == rgb{255, 0, 0}));
+  CHECK((hsv2rgb(0.5f, NAN, 1) == rgb{255, 255, 255}));
+  CHECK((hsv2rgb(0.5f, 1, NAN) == rgb{0, 0, 0}));
+  CHECK((hsv2rgb(0.5f, 0, NAN) == rgb{0, 0, 0}));
+  CHECK(unit_to_uint8(NAN) == 0);
+}
+
+void test_hue() {
+  // the hue wraps around and a hue which rounds to 1 is red
+  CHECK((hsv2rgb(0, 1, 1) == rgb{255, 0, 0}));
+  CHECK((hsv2rgb(1, 1, 1) == rgb{255, 0, 0}));
+  CHECK((hsv2rgb(-1e-9f, 1, 1) == rgb{255, 0, 0}));
+  CHECK((hsv2rgb(std::nextafter(1.0f, 0.0f), 1, 1) == rgb{255, 0, 0}));
+  CHECK((hsv2rgb(-0.25f, 1, 1) == hsv2rgb(0.75f, 1, 1)));
+  CHECK((hsv2rgb(2.0f / 6, 1, 1) == rgb{0, 255, 0}));
+  CHECK((hsv2rgb(4.0f / 6, 1, 1) == rgb{0, 0, 255}));
+  for (int i = -600; i <= 600; i++) {
+    const float h = i / 300.0f;
+    const auto value = hsv2rgb(h, 0.75f, 0.5f);
+    const auto expected = reference_hsv2rgb(h, 0.75, 0.5);
+    for (int c = 0; c < 3; c++) CHECK(std::abs(value[c] - expected[c]) <= 1);
+  }
+}
+
+} // namespace
+
+int main() {
+  test_wheel();
+  test_invalid();
+  test_hue();
+  return test_result("test_color");
+}
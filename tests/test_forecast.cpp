@@ -0,0 +1,160 @@
+// parse_forecast and WeatherForecast: HA forecast layouts, edge cases and a fuzz
+// loop over mutated forecasts (see forecast.h)
+#include "forecast.h"
+#include "forecast_data.h"
+#include "test.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+constexpr uint8_t MAX_ENTRIES = WeatherForecast::MAX_ENTRIES;
+// 2023-08-22T21:00:00+00:00
+constexpr time_t HOURLY_START = 1692738000;
+// 2023-08-22T10:00:00+02:00
+constexpr time_t DAILY_START = 1692691200;
+
+int8_t parse(const std::string &data, std::vector<ForecastEntry> &entries, uint8_t max_entries = MAX_ENTRIES) {
+  entries.assign(max_entries, ForecastEntry{});
+  auto count = parse_forecast(data.data(), data.size(), entries.data(), max_entries);
+  entries.resize(count < 0 ? 0 : count);
+  return count;
+}
+
+bool terminated(const char *str, size_t size) { return std::memchr(str, '\0', size) != nullptr; }
+
+void test_hourly() {
+  for (bool json : {false, true}) {
+    std::vector<ForecastEntry> entries;
+    CHECK(parse(make_hourly_forecast(48, json), entries) == MAX_ENTRIES);
+    for (uint8_t i = 0; i < entries.size(); i++) {
+      CHECK(entries[i].time == HOURLY_START + i * 3600);
+      CHECK(std::fabs(entries[i].temperature - (16.4f - i * 0.1f)) < 0.001f);
+    }
+    CHECK(std::strcmp(entries[0].datetime, "2023-08-22T21:00:00+00:00") == 0);
+    CHECK(std::strcmp(entries[1].condition, "partlycloudy") == 0);
+
+    WeatherForecast forecast;
+    CHECK(forecast.update(make_hourly_forecast(48, json).c_str(), make_hourly_forecast(48, json).size()));
+    CHECK(forecast.size() == MAX_ENTRIES && forecast.is_hourly() && forecast.get_period() == 3600);
+    CHECK(forecast.get_next_expiry() == HOURLY_START + 3600);
+  }
+}
+
+void test_daily() {
+  for (bool json : {false, true}) {
+    std::vector<ForecastEntry> entries;
+    CHECK(parse(make_daily_forecast(5, json), entries) == 5);
+    CHECK(entries[0].time == DAILY_START);
+    CHECK(entries[4].time == DAILY_START + 4 * 86400);
+    CHECK(entries[0].temperature == 21.5f);
+    // None/null temperatures
+    CHECK(std::isnan(entries[4].temperature));
+
+    WeatherForecast forecast;
+    const auto data = make_daily_forecast(5, json);
+    CHECK(forecast.update(data.c_str(), data.size()));
+    CHECK(!forecast.is_hourly() && forecast.get_period() == 86400);
+    CHECK(!forecast.expire(DAILY_START + 86399));
+    CHECK(forecast.expire(DAILY_START + 2 * 86400));
+    CHECK(forecast.size() == 3 && forecast.at(0).time == DAILY_START + 2 * 86400);
+    // unparsable data keeps the cached entries
+    CHECK(!forecast.update("[{'condition'}]", 15));
+    CHECK(forecast.size() == 3);
+    CHECK(forecast.update("[]", 2) && forecast.empty());
+  }
+}
+
+void test_strings() {
+  std::vector<ForecastEntry> entries;
+  // escaped quotes in values and skipped keys, mixed quoting
+  CHECK(parse("[{\"cond\\\"x\": \"a\\\"b\", 'condition': 'it\\'s sunny', \"temperature\": -3.5e0}]", entries) == 1);
+  CHECK(std::strcmp(entries[0].condition, "it's sunny") == 0);
+  CHECK(entries[0].temperature == -3.5f);
+  CHECK(entries[0].time == 0);
+
+  // over-long values are truncated to the buffer sizes
+  const std::string condition(40, 'c');
+  CHECK(parse("[{'condition': '" + condition + "', 'datetime': '2023-08-22T21:00:00.123456+00:00'}]", entries) == 1);
+  CHECK(std::strlen(entries[0].condition) == sizeof(ForecastEntry::condition) - 1);
+  CHECK(std::strlen(entries[0].datetime) == sizeof(ForecastEntry::datetime) - 1);
+  // the time is parsed from the whole value
+  CHECK(entries[0].time == HOURLY_START);
+
+  // nested values of unknown keys are skipped
+  CHECK(parse("[{'extra': {'a': [1, {'b': ']'}], 'c': '}'}, 'condition': 'fog'}, {}]", entries) == 2);
+  CHECK(std::strcmp(entries[0].condition, "fog") == 0);
+  CHECK(entries[1].condition[0] == '\0' && std::isnan(entries[1].temperature));
+}
+
+void test_malformed() {
+  std::vector<ForecastEntry> entries;
+  for (const char *data : {"", "{}", "[", "[{", "[{'condition'", "[{'condition':", "[{'condition': 'x'",
+      "[{'condition': 'x',}]", "[{'temperature': }]", "[1, 2]", "[{'condition': x}]", "[{'a': [}]"}) {
+    CHECK(parse(data, entries) == -1);
+  }
+  CHECK(parse("[]", entries) == 0);
+  CHECK(parse(" [ ] ", entries) == 0);
+  CHECK(parse("[{}]", entries, 0) == 0);
+  // the entries past max_entries are never scanned
+  CHECK(parse("[{}, {}, not json", entries, 2) == 2);
+
+  // a truncated forecast returns the complete entries before the truncation
+  std::vector<ForecastEntry> all;
+  const auto data = make_hourly_forecast(4);
+  CHECK(parse(data, all) == 4);
+  for (size_t length = 0; length < data.size(); length++) {
+    const auto count = parse(data.substr(0, length), entries);
+    CHECK(count >= -1 && count <= 4);
+    for (int8_t i = 0; i < count; i++) {
+      CHECK(entries[i].time == all[i].time && std::strcmp(entries[i].condition, all[i].condition) == 0);
+    }
+  }
+}
+
+// Random edits of valid forecasts, the parser must stay in bounds (ASAN) and
+// always return terminated strings
+void fuzz(unsigned long iterations) {
+  std::mt19937 rng(3);
+  static const char SPECIAL[] = "[]{}'\",:\\ .-+e0N";
+  const std::string sources[] = {make_hourly_forecast(10), make_daily_forecast(3, true), "[{'a': [[[[{}]]]]}]"};
+  for (unsigned long n = 0; n < iterations; n++) {
+    std::string data = sources[n % 3];
+    const int edits = 1 + rng() % 4;
+    for (int k = 0; k < edits && !data.empty(); k++) {
+      const size_t pos = rng() % data.size();
+      switch (rng() % 4) {
+        case 0: data[pos] = SPECIAL[rng() % (sizeof(SPECIAL) - 1)]; break;
+        case 1: data.erase(pos, 1 + rng() % 8); break;
+        case 2: data.insert(pos, 1, SPECIAL[rng() % (sizeof(SPECIAL) - 1)]); break;
+        case 3: data.resize(pos); break;
+      }
+    }
+    // an exact size heap copy so ASAN catches reads past the end
+    std::vector<char> buffer(data.begin(), data.end());
+    std::vector<ForecastEntry> entries(MAX_ENTRIES);
+    const auto count = parse_forecast(buffer.data(), buffer.size(), entries.data(), MAX_ENTRIES);
+    CHECK(count >= -1 && count <= MAX_ENTRIES);
+    for (int8_t i = 0; i < count; i++) {
+      CHECK(terminated(entries[i].datetime, sizeof(entries[i].datetime)));
+      CHECK(terminated(entries[i].condition, sizeof(entries[i].condition)));
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  test_hourly();
+  test_daily();
+  test_strings();
+  test_malformed();
+  fuzz(fuzz_iterations(200000));
+  return test_result("test_forecast");
+}
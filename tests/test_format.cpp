@@ -0,0 +1,79 @@
+// append_number/append_fixed/append_float compared against snprintf (see helpers.h)
+#include "helpers.h"
+#include "test.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+std::string printf_float(float value, int decimals) {
+  char str[64];
+  snprintf(str, sizeof(str), "%.*f", decimals, value);
+  // append_float doesn't print a negative zero
+  if (std::strspn(str, "-0.") == std::strlen(str) && str[0] == '-') return str + 1;
+  return str;
+}
+
+std::string format_float(float value, uint8_t decimals) {
+  std::string buffer;
+  return append_float(buffer, value, decimals);
+}
+
+void test_fixed_cases() {
+  std::string buffer;
+  CHECK(append_number(buffer, 0) == "0");
+  buffer.clear();
+  CHECK(append_number(buffer, INT32_MIN) == "-2147483648");
+  buffer.clear();
+  CHECK(append_number(buffer, UINT32_MAX) == "4294967295");
+  buffer.clear();
+  CHECK(append_fixed(buffer, 215, 1) == "21.5");
+  buffer.clear();
+  CHECK(append_fixed(buffer, -5, 2) == "-0.05");
+  buffer.clear();
+  CHECK(append_fixed(buffer, 7, 0) == "7");
+
+  // ties and near ties must round like printf
+  CHECK(format_float(21.05f, 1) == "21.0");
+  CHECK(format_float(0.25f, 1) == "0.2");
+  CHECK(format_float(0.35f, 1) == "0.3");
+  CHECK(format_float(2.5f, 0) == "2");
+  CHECK(format_float(3.5f, 0) == "4");
+  CHECK(format_float(-0.04f, 1) == "0.0");
+  CHECK(format_float(NAN, 1) == "nan");
+  CHECK(format_float(1e12f, 1) == printf_float(1e12f, 1));
+}
+
+void fuzz(unsigned long iterations) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> small(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> large(-300000.0f, 300000.0f);
+  for (unsigned long n = 0; n < iterations; n++) {
+    const uint8_t decimals = rng() % 5;
+    float value = (n & 1) ? small(rng) : large(rng);
+    // values close to a printed tie, e.g. 21.05
+    if (n % 4 == 2) value = std::round(value * 100.0f) / 100.0f + 0.005f * (rng() % 3);
+    CHECK(format_float(value, decimals) == printf_float(value, decimals));
+
+    const int32_t fixed = static_cast<int32_t>(rng());
+    std::string buffer;
+    char expected[16];
+    snprintf(expected, sizeof(expected), "%s%u.%02u", fixed < 0 ? "-" : "",
+        static_cast<unsigned>(std::abs(static_cast<int64_t>(fixed)) / 100),
+        static_cast<unsigned>(std::abs(static_cast<int64_t>(fixed)) % 100));
+    CHECK(append_fixed(buffer, fixed, 2) == expected);
+  }
+}
+
+} // namespace
+
+int main() {
+  test_fixed_cases();
+  fuzz(fuzz_iterations(200000));
+  return test_result("test_format");
+}
@@ -0,0 +1,61 @@
+// make_frozen_map/find_value/find_prefix_range (see types.h)
+#include "types.h"
+#include "test.h"
+
+#include <string>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+template <typename Value, size_t Size>
+void check_map(const FrozenCharMap<Value, Size> &map) {
+  CHECK(is_frozen_map_sorted(map));
+  for (size_t i = 0; i < Size; i++) {
+    // a copy so the key isn't found by pointer
+    const std::string key(map[i].first);
+    // duplicate keys find the first item
+    size_t first = i;
+    while (first > 0 && key == map[first - 1].first) first--;
+    CHECK(find_value(map, key.c_str()) == &map[first].second);
+    CHECK(find_value(map, (key + "_missing").c_str()) == nullptr);
+  }
+  CHECK(find_value(map, "") == nullptr);
+  CHECK(find_value(map, static_cast<const char *>(nullptr)) == nullptr);
+}
+
+constexpr FrozenCharMap<int, 6> TEST_MAP = make_frozen_map<int, 6>({{
+  {"sensor.b", 1}, {"binary_sensor.a", 2}, {"sensor.a", 3},
+  {"binary_sensor.b", 4}, {"light", 5}, {"sensor.a", 6},
+}});
+static_assert(is_frozen_map_sorted(TEST_MAP), "TEST_MAP must be built with make_frozen_map");
+
+void test_map() {
+  check_map(TEST_MAP);
+  // duplicate keys find the first one in the initialiser list
+  CHECK(*find_value(TEST_MAP, "sensor.a") == 3);
+  CHECK(*find_value(TEST_MAP, "missing", "light") == 5);
+
+  auto range = find_prefix_range(TEST_MAP, "binary_sensor.");
+  CHECK(range.end - range.begin == 2);
+  CHECK(*find_value(range, "b") == 4);
+  CHECK(find_value(range, "c") == nullptr);
+  CHECK(find_prefix_range(TEST_MAP, "switch.").empty());
+}
+
+} // namespace
+
+int main() {
+  test_map();
+  check_map(ENTITY_ICON_MAP);
+  check_map(SENSOR_ON_ICON_MAP);
+  check_map(SENSOR_OFF_ICON_MAP);
+  check_map(SENSOR_ICON_MAP);
+  check_map(WEATHER_ICON_MAP);
+  check_map(CLIMATE_ICON_MAP);
+  check_map(MEDIA_TYPE_ICON_MAP);
+  check_map(ALARM_ICON_MAP);
+  check_map(COVER_MAP);
+  check_map(ENTITY_RENDER_TYPE_MAP);
+  return test_result("test_frozen_map");
+}
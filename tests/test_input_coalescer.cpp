@@ -0,0 +1,125 @@
+// InputCoalescer: replays recorded slider drags and checks the events which are
+// passed through (see input_coalescer.h)
+#include "input_coalescer.h"
+#include "test.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+struct Event {
+  uint32_t time;
+  std::string id;
+  std::string button_type;
+  std::string value;
+};
+
+// Runs the events through the coalescer the way NSPanelLovelace does,
+// flushing on each event and when the returned delay has passed
+std::vector<Event> replay(InputCoalescer &coalescer, std::vector<Event> events, uint32_t duration) {
+  std::stable_sort(events.begin(), events.end(),
+    [](const Event &a, const Event &b) { return a.time < b.time; });
+  std::vector<Event> sent;
+  uint32_t flush_at = 0;
+  auto flush = [&](uint32_t now) {
+    const uint32_t delay = coalescer.flush(now,
+      [&](const std::string &id, const std::string &button_type, const std::string &value) {
+        sent.push_back({now, id, button_type, value});
+      });
+    flush_at = delay == 0 ? 0 : now + delay;
+  };
+  size_t next = 0;
+  for (uint32_t now = 0; now < duration; now++) {
+    if (flush_at != 0 && now >= flush_at) flush(now);
+    while (next < events.size() && events[next].time == now) {
+      const Event &event = events[next++];
+      if (coalescer.on_event(event.id, event.button_type, event.value, now)) sent.push_back(event);
+      flush(now);
+    }
+  }
+  CHECK(flush_at == 0);
+  return sent;
+}
+
+std::vector<Event> of_type(const std::vector<Event> &events, const std::string &button_type) {
+  std::vector<Event> result;
+  for (const auto &event : events) {
+    if (event.button_type == button_type) result.push_back(event);
+  }
+  return result;
+}
+
+void test_drags() {
+  InputCoalescer coalescer;
+  coalescer.set_interval("positionSlider", 500);
+  coalescer.set_interval("tiltSlider", 0);
+  CHECK(coalescer.get_interval("brightnessSlider") == DEFAULT_INPUT_INTERVAL);
+  CHECK(coalescer.get_interval("positionSlider") == 500);
+
+  // brightness 1..100 every 15ms with a colour temp drag of another light interleaved
+  std::vector<Event> events;
+  for (int i = 1; i <= 100; i++) {
+    events.push_back({static_cast<uint32_t>(1000 + i * 15), "uuid.a", "brightnessSlider", std::to_string(i)});
+  }
+  for (int i = 1; i <= 40; i++) {
+    events.push_back({static_cast<uint32_t>(1200 + i * 25), "uuid.b", "colorTempSlider", std::to_string(150 + i * 5)});
+  }
+  for (int i = 1; i <= 10; i++) {
+    events.push_back({static_cast<uint32_t>(5000 + i * 30), "uuid.c", "tiltSlider", std::to_string(i * 10)});
+  }
+  const auto sent = replay(coalescer, events, 10000);
+
+  for (const char *button_type : {"brightnessSlider", "colorTempSlider", "tiltSlider"}) {
+    const auto received = of_type(events, button_type);
+    const auto passed = of_type(sent, button_type);
+    // the first event is passed through immediately and the final value is never lost
+    CHECK(passed.front().time == received.front().time);
+    CHECK(passed.front().value == received.front().value);
+    CHECK(passed.back().value == received.back().value);
+    const uint16_t interval = coalescer.get_interval(button_type);
+    if (interval == 0) {
+      CHECK(passed.size() == received.size());
+      continue;
+    }
+    CHECK(passed.size() < received.size() / 4);
+    for (size_t i = 1; i < passed.size(); i++) CHECK(passed[i].time - passed[i - 1].time >= interval);
+  }
+  CHECK(coalescer.get_events_received() == events.size());
+  CHECK(coalescer.get_events_sent() == sent.size());
+}
+
+void test_other_control_drops_held_value() {
+  InputCoalescer coalescer;
+  // a brightness drag which ends with the light being switched off
+  std::vector<Event> events;
+  for (int i = 1; i <= 10; i++) {
+    events.push_back({static_cast<uint32_t>(100 + i * 20), "uuid.a", "brightnessSlider", std::to_string(i * 10)});
+  }
+  events.push_back({310, "uuid.a", "OnOff", "0"});
+  // another light keeps its held value
+  events.push_back({200, "uuid.b", "brightnessSlider", "10"});
+  events.push_back({220, "uuid.b", "brightnessSlider", "20"});
+  const auto sent = replay(coalescer, events, 2000);
+
+  // nothing is sent for the light after it was switched off
+  auto last = std::find_if(sent.rbegin(), sent.rend(),
+    [](const Event &event) { return event.id == "uuid.a"; });
+  CHECK(last != sent.rend() && last->button_type == "OnOff" && last->time == 310);
+  const auto passed = of_type(sent, "brightnessSlider");
+  CHECK(passed.back().id == "uuid.b" && passed.back().value == "20");
+
+  // the next drag of the dropped control is passed through immediately
+  CHECK(coalescer.on_event("uuid.a", "brightnessSlider", "50", 3000));
+}
+
+} // namespace
+
+int main() {
+  test_drags();
+  test_other_control_drops_held_value();
+  return test_result("test_input_coalescer");
+}
@@ -0,0 +1,129 @@
+// iso8601_to_epoch compared with timegm for random timestamps, offsets and
+// fractional seconds, plus leap days and malformed/truncated strings (see helpers.h)
+#include "helpers.h"
+#include "test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <time.h>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+time_t parse(const char *str) {
+  time_t epoch = -1;
+  return iso8601_to_epoch(str, epoch) ? epoch : -1;
+}
+
+time_t reference_epoch(int year, int month, int day, int hour, int minute, int second) {
+  tm t{};
+  t.tm_year = year - 1900;
+  t.tm_mon = month - 1;
+  t.tm_mday = day;
+  t.tm_hour = hour;
+  t.tm_min = minute;
+  t.tm_sec = second;
+  return timegm(&t);
+}
+
+void test_fixed_cases() {
+  CHECK(parse("1970-01-01") == 0);
+  CHECK(parse("1970-01-01T00:00:00Z") == 0);
+  CHECK(parse("2023-08-22T21:00:00+00:00") == 1692738000);
+  CHECK(parse("2023-08-22 21:00:00") == 1692738000);
+  CHECK(parse("2023-08-22T21:00") == 1692738000);
+  CHECK(parse("2023-08-22T23:30:00+02:30") == 1692738000);
+  CHECK(parse("2023-08-22T23:30:00+0230") == 1692738000);
+  CHECK(parse("2023-08-22T20:00:00-01") == 1692738000);
+  CHECK(parse("2023-08-22T21:00:00.123456+00:00") == 1692738000);
+  CHECK(parse("2023-08-22T21:00:00.5Z") == 1692738000);
+  // the offset moves the date
+  CHECK(parse("2023-08-23T01:00:00+04:00") == 1692738000);
+  CHECK(parse("2023-08-22T17:00:00-04:00") == 1692738000);
+
+  // leap days
+  CHECK(parse("2024-02-29") == reference_epoch(2024, 2, 29, 0, 0, 0));
+  CHECK(parse("2000-02-29T12:00:00Z") == reference_epoch(2000, 2, 29, 12, 0, 0));
+  CHECK(parse("2023-02-29") == -1);
+  CHECK(parse("1900-02-29") == -1);
+  CHECK(parse("2100-02-29") == -1);
+  CHECK(parse("2024-03-01") - parse("2024-02-28") == 2 * 86400);
+  CHECK(parse("2023-03-01") - parse("2023-02-28") == 86400);
+
+  time_t epoch = 7;
+  CHECK(!iso8601_to_epoch(nullptr, epoch) && epoch == 7);
+}
+
+void test_malformed() {
+  for (const char *str : {"", "2023", "2023-08", "2023-8-22", "23-08-22", "2023/08/22",
+      "2023-00-22", "2023-13-22", "2023-08-00", "2023-08-32", "2023-04-31",
+      "2023-08-22T", "2023-08-22T21", "2023-08-22T21:", "2023-08-22T21:0", "2023-08-22T2100",
+      "2023-08-22T24:00", "2023-08-22T21:60", "2023-08-22T21:00:61", "2023-08-22T21:00:0",
+      "2023-08-22T21:00:00.", "2023-08-22T21:00:00.Z", "2023-08-22T21:00:00+", "2023-08-22T21:00:00+1",
+      "2023-08-22T21:00:00+01:", "2023-08-22T21:00:00+01:0", "2023-08-22T21:00:00+24:00",
+      "2023-08-22T21:00:00+01:60", "2023-08-22T21:00:00Z+01:00", "2023-08-22T21:00:00ZZ",
+      "2023-08-22x", "2023-08-22T21:00:00 ", " 2023-08-22", "2023-08-22T21:00:00+01:00:00"}) {
+    if (parse(str) != -1) std::fprintf(stderr, "accepted: '%s'\n", str);
+    CHECK(parse(str) == -1);
+  }
+
+  // every prefix of a full timestamp is either rejected or one of the shorter layouts
+  const std::string full = "2023-08-22T21:00:00.123+02:00";
+  for (size_t length = 0; length < full.size(); length++) {
+    const auto prefix = full.substr(0, length);
+    const time_t epoch = parse(prefix.c_str());
+    const bool valid_layout = length == 10 || length == 16 || length == 19 || (length >= 21 && length <= 23) ||
+        length == 26;
+    CHECK((epoch != -1) == valid_layout);
+  }
+}
+
+// Random timestamps (1970-2099) formatted in each layout, compared with timegm
+void fuzz(unsigned long iterations) {
+  std::mt19937 rng(7);
+  for (unsigned long n = 0; n < iterations; n++) {
+    const time_t utc = static_cast<time_t>(rng() % 4102444800u);
+    // offsets in 15 minute steps from -12:00 to +14:00
+    const int offset = (static_cast<int>(rng() % 105) - 48) * 15 * 60;
+    const time_t local = utc + offset;
+    tm t;
+    gmtime_r(&local, &t);
+    CHECK(reference_epoch(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec) == local);
+
+    char str[48];
+    const int length = std::snprintf(str, sizeof(str), "%04d-%02d-%02d%c%02d:%02d:%02d",
+      t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, (n & 1) ? 'T' : ' ', t.tm_hour, t.tm_min, t.tm_sec);
+    char *end = str + length;
+    if (n % 3 == 0) end += std::snprintf(end, 8, ".%u", static_cast<unsigned>(rng() % 1000000));
+    const int abs_offset = offset < 0 ? -offset : offset;
+    switch (n % 4) {
+      case 0:
+        std::snprintf(end, 8, "%c%02d:%02d", offset < 0 ? '-' : '+', abs_offset / 3600, abs_offset / 60 % 60);
+        CHECK(parse(str) == utc);
+        break;
+      case 1:
+        std::snprintf(end, 8, "%c%02d%02d", offset < 0 ? '-' : '+', abs_offset / 3600, abs_offset / 60 % 60);
+        CHECK(parse(str) == utc);
+        break;
+      case 2:
+        std::snprintf(end, 8, "Z");
+        CHECK(parse(str) == local);
+        break;
+      default:
+        CHECK(parse(str) == local);
+        break;
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  test_fixed_cases();
+  test_malformed();
+  fuzz(fuzz_iterations(200000));
+  return test_result("test_iso8601");
+}
@@ -0,0 +1,132 @@
+// parse_uint/parse_int/parse_fixed/parse_float: fixed cases and a fuzz
+// comparison against strtoll/strtod (see helpers.h)
+#include "helpers.h"
+#include "test.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+// strtoll restricted to what parse_int accepts (whole string, no whitespace)
+bool reference_int(const std::string &str, int32_t &value) {
+  if (str.empty()) return false;
+  size_t start = (str[0] == '+' || str[0] == '-') ? 1 : 0;
+  if (start == str.size()) return false;
+  for (size_t i = start; i < str.size(); i++) {
+    if (str[i] < '0' || str[i] > '9') return false;
+  }
+  errno = 0;
+  char *end;
+  long long result = std::strtoll(str.c_str(), &end, 10);
+  if (errno != 0 || *end != '\0' || result < INT32_MIN || result > INT32_MAX) return false;
+  value = static_cast<int32_t>(result);
+  return true;
+}
+
+bool reference_float(const std::string &str, float &value) {
+  if (str.empty()) return false;
+  for (char c : str) {
+    if (std::strchr("0123456789+-.eE", c) == nullptr) return false;
+  }
+  char *end;
+  double result = std::strtod(str.c_str(), &end);
+  if (*end != '\0') return false;
+  value = static_cast<float>(result);
+  return true;
+}
+
+void test_fixed_cases() {
+  uint32_t u = 7;
+  CHECK(parse_uint("0", u) && u == 0);
+  CHECK(parse_uint("+42", u) && u == 42);
+  CHECK(parse_uint("4294967295", u) && u == 4294967295u);
+  CHECK(!parse_uint("4294967296", u) && u == 4294967295u);
+  CHECK(!parse_uint("-1", u));
+  CHECK(!parse_uint("", u));
+  CHECK(!parse_uint("+", u));
+  CHECK(!parse_uint(" 1", u));
+  CHECK(!parse_uint("1 ", u));
+
+  int32_t i = 7;
+  CHECK(parse_int("-2147483648", i) && i == INT32_MIN);
+  CHECK(parse_int("2147483647", i) && i == INT32_MAX);
+  CHECK(!parse_int("2147483648", i) && i == INT32_MAX);
+  CHECK(!parse_int("-2147483649", i));
+  CHECK(!parse_int("-", i));
+  CHECK(!parse_int("1.0", i));
+  CHECK(!parse_int(nullptr, 0, i));
+
+  int32_t f = 7;
+  CHECK(parse_fixed("21.5", 1, f) && f == 215);
+  CHECK(parse_fixed("21", 1, f) && f == 210);
+  CHECK(parse_fixed("-3.25", 1, f) && f == -33);
+  CHECK(parse_fixed("0.35", 2, f) && f == 35);
+  CHECK(parse_fixed(".5", 1, f) && f == 5);
+  CHECK(parse_fixed("5.", 1, f) && f == 50);
+  CHECK(!parse_fixed(".", 1, f));
+  CHECK(!parse_fixed("1.2.3", 1, f));
+  CHECK(!parse_fixed("214748364.8", 1, f));
+
+  float v = 7.0f;
+  CHECK(parse_float("21.5", v) && v == 21.5f);
+  CHECK(parse_float("-0.35", v) && v == -0.35f);
+  CHECK(parse_float("2e3", v) && v == 2000.0f);
+  CHECK(parse_float("1.5E-2", v) && v == 0.015f);
+  CHECK(!parse_float("nan", v));
+  CHECK(!parse_float("inf", v));
+  CHECK(!parse_float("0x10", v));
+  CHECK(!parse_float("1e", v));
+  CHECK(!parse_float("1e999", v));
+  CHECK(!parse_float("", v));
+
+  CHECK(value_or_default(std::string("abc"), 5) == 5);
+  CHECK(value_or_default(std::string("12"), 5) == 12);
+  CHECK(value_or_default(std::string("0.5"), 1.0f) == 0.5f);
+  CHECK(fixed_or_default(std::string("21.05"), 1, 0) == 211);
+}
+
+void fuzz(unsigned long iterations) {
+  std::mt19937 rng(1);
+  static const char ALPHABET[] = "0123456789+-.eE x";
+  for (unsigned long n = 0; n < iterations; n++) {
+    std::string str;
+    const int length = rng() % 12;
+    // signs and spaces are more likely at the start
+    for (int k = 0; k < length; k++) str += ALPHABET[rng() % (k < 2 ? 17 : 14)];
+
+    int32_t a = 7, b = 7;
+    bool parsed = parse_int(str, a), reference = reference_int(str, b);
+    CHECK(parsed == reference && a == b);
+
+    float fa = 7.0f, fb = 7.0f;
+    parsed = parse_float(str, fa);
+    reference = reference_float(str, fb);
+    // parse_float doesn't accept anything strtod rejects, strtod accepts some
+    // forms parse_float doesn't (e.g. "1e" as 1), only compare values both accept
+    CHECK(!parsed || reference);
+    if (parsed && reference) {
+      const float diff = std::fabs(fa - fb);
+      CHECK(diff <= std::fabs(fb) * 4e-7f || diff <= 1e-37f);
+    }
+
+    int32_t fixed;
+    if (parse_fixed(str, 1, fixed)) {
+      const double expected = std::strtod(str.c_str(), nullptr) * 10;
+      CHECK(std::fabs(expected - fixed) <= 0.5000001);
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  test_fixed_cases();
+  fuzz(fuzz_iterations(200000));
+  return test_result("test_parse");
+}
@@ -0,0 +1,96 @@
+// ServiceCall: counts the heap allocations made while building a call, the only
+// ones allowed are for the api message itself (see service_call.h)
+#include "service_call.h"
+#include "test.h"
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace esphome;
+using namespace esphome::nspanel_lovelace;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  if (void *ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// longer than the small string buffer so each copy of them allocates
+const std::string ENTITY_ID = "light.living_room_ceiling_spots";
+const std::string RGB = "[255, 128, 64] (a value longer than sso)";
+const std::string BRIGHTNESS = "128";
+
+// The allocations made by copying the message, i.e. the storage it needs
+size_t message_allocations(const api::HomeassistantServiceResponse &resp) {
+  const size_t before = allocations;
+  api::HomeassistantServiceResponse copy = resp;
+  return allocations - before;
+}
+
+void test_build(const char *action_prefix, const char *action) {
+  const size_t before = allocations;
+  ServiceCall call("light", action_prefix, action, ENTITY_ID);
+  call.coalesce()
+    .add(ha_attr_type::brightness, BRIGHTNESS)
+    .add(ha_attr_type::color_temp, "2")
+    .add_template(ha_attr_type::rgb_color, RGB);
+  CHECK(allocations == before);
+
+  api::HomeassistantServiceResponse resp;
+  size_t build_before = allocations;
+  call.build(resp);
+  const size_t build_allocations = allocations - build_before;
+  CHECK(build_allocations == message_allocations(resp));
+
+  std::string service;
+  call.append_service(service);
+  CHECK(resp.service == service);
+  CHECK(resp.data.size() == 3 && resp.data_template.size() == 1);
+  CHECK(resp.data[0].key == "entity_id" && resp.data[0].value == ENTITY_ID);
+  CHECK(resp.data[1].key == "brightness" && resp.data[1].value == BRIGHTNESS);
+  CHECK(resp.data[2].key == "color_temp" && resp.data[2].value == "2");
+  CHECK(resp.data_template[0].key == "rgb_color" && resp.data_template[0].value == RGB);
+
+  // the message storage is reused when it is built again
+  build_before = allocations;
+  call.build(resp);
+  CHECK(allocations == build_before);
+  CHECK(resp.service == service && resp.data.size() == 3);
+
+  // and a smaller call fits in the storage of a larger one
+  ServiceCall smaller("light", ha_action_type::turn_off, ENTITY_ID);
+  build_before = allocations;
+  smaller.build(resp);
+  CHECK(allocations == build_before);
+  CHECK(resp.service == "light.turn_off");
+  CHECK(resp.data.size() == 1 && resp.data_template.empty());
+  CHECK(resp.data[0].value == ENTITY_ID);
+}
+
+void test_is_service() {
+  ServiceCall call("alarm_control_panel", "alarm_", "arm_home", ENTITY_ID);
+  CHECK(call.is_service("alarm_control_panel.alarm_arm_home"));
+  CHECK(!call.is_service("alarm_control_panel.alarm_arm_away"));
+  CHECK(!call.is_service("alarm_control_panel.alarm_arm_home_"));
+  CHECK(!call.is_service("alarm_control_panel_alarm_arm_home"));
+  CHECK(call.get_param() == nullptr);
+  call.add(ha_attr_type::code, "1234");
+  CHECK(call.get_param() != nullptr && std::string(call.get_param()) == "code");
+}
+
+} // namespace
+
+int main() {
+  test_build("", ha_action_type::turn_on);
+  // a service name longer than the small string buffer
+  test_build("", "turn_on_with_a_long_service_name");
+  test_is_service();
+  return test_result("test_service_call");
+}
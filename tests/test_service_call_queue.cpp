@@ -0,0 +1,108 @@
+// ServiceCallQueue: simulates slider drags against a HA which applies calls one
+// at a time and checks the calls which are sent (see service_call_queue.h)
+#include "service_call_queue.h"
+#include "test.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+const std::string ENTITY_ID = "light.living_room";
+
+// note: ServiceCall references its values so the call is submitted in place
+void submit_brightness(ServiceCallQueue &queue, const std::string &entity_id, const std::string &value) {
+  ServiceCall call("light", ha_action_type::turn_on, entity_id);
+  queue.submit(call.coalesce().add(ha_attr_type::brightness, value));
+}
+
+struct DragResult {
+  int events = 0;
+  int sent = 0;
+  std::string applied;
+  std::string last_value;
+};
+
+// HA applies the calls in order, each takes apply_ms and is followed by a state update
+DragResult drag(uint32_t apply_ms, uint32_t drag_ms, uint32_t event_every) {
+  ServiceCallQueue queue;
+  DragResult result;
+  std::deque<std::string> backlog;
+  uint32_t applied_at = 0;
+  auto send = [&](const api::HomeassistantServiceResponse &resp) {
+    result.sent++;
+    CHECK(resp.service == "light.turn_on");
+    CHECK(resp.data.size() == 2 && resp.data[0].value == ENTITY_ID);
+    backlog.push_back(resp.data[1].value);
+  };
+  for (uint32_t now = 0; now < drag_ms + 10000; now++) {
+    if (now > 0 && now <= drag_ms && now % event_every == 0) {
+      result.events++;
+      result.last_value = std::to_string(now * 100 / drag_ms);
+      submit_brightness(queue, ENTITY_ID, result.last_value);
+    }
+    if (!backlog.empty() && applied_at == 0) applied_at = now + apply_ms;
+    if (applied_at != 0 && now >= applied_at) {
+      result.applied = backlog.front();
+      backlog.pop_front();
+      applied_at = 0;
+      queue.on_entity_update(ENTITY_ID);
+    }
+    queue.flush(now, send);
+  }
+  CHECK(backlog.empty());
+  CHECK(queue.get_calls_submitted() == static_cast<uint32_t>(result.events));
+  CHECK(queue.get_calls_sent() == static_cast<uint32_t>(result.sent));
+  return result;
+}
+
+void test_drags() {
+  for (uint32_t apply_ms : {50u, 300u, 800u}) {
+    const auto result = drag(apply_ms, 2000, 20);
+    // the final value is always applied and the calls are bounded by the HA round trip
+    CHECK(result.applied == result.last_value);
+    CHECK(result.sent <= static_cast<int>(2000 / (apply_ms > SERVICE_CALL_MIN_SPACING ? apply_ms : SERVICE_CALL_MIN_SPACING)) + 2);
+    CHECK(result.sent < result.events);
+  }
+}
+
+void test_pending_calls_flushed_before_other_calls() {
+  ServiceCallQueue queue;
+  std::vector<std::string> sent;
+  auto send = [&](const api::HomeassistantServiceResponse &resp) {
+    sent.push_back(resp.service + (resp.data.size() > 1 ? "=" + resp.data[1].value : ""));
+  };
+  submit_brightness(queue, ENTITY_ID, "10");
+  CHECK(queue.flush(0, send) == 0);
+  // in flight, the next value is held
+  submit_brightness(queue, ENTITY_ID, "20");
+  CHECK(queue.flush(10, send) != 0);
+  CHECK(sent.size() == 1);
+
+  // another entity's held value is left alone
+  submit_brightness(queue, "light.kitchen", "30");
+  queue.flush(20, send);
+  submit_brightness(queue, "light.kitchen", "40");
+  CHECK(queue.flush(20, send) != 0);
+  CHECK(sent.size() == 2);
+
+  // the held value is sent before the call which isn't coalesced
+  queue.flush_entity(ENTITY_ID, 30, send);
+  CHECK((sent == std::vector<std::string>{"light.turn_on=10", "light.turn_on=30", "light.turn_on=20"}));
+  // nothing is left to undo the turn_off sent next
+  sent.clear();
+  for (uint32_t now = 30; now < 3000; now++) queue.flush(now, send);
+  CHECK((sent == std::vector<std::string>{"light.turn_on=40"}));
+}
+
+} // namespace
+
+int main() {
+  test_drags();
+  test_pending_calls_flushed_before_other_calls();
+  return test_result("test_service_call_queue");
+}
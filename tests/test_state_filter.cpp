@@ -0,0 +1,90 @@
+// Entity state filters: precision, deadband and rate limiting (see entity.h)
+#include "entity.h"
+#include "esphome/core/hal.h"
+#include "test.h"
+
+#include <string>
+
+using namespace esphome;
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+struct StateSubscriber : IEntitySubscriber {
+  std::string state;
+  int count = 0;
+  void on_entity_state_change(const std::string &value) override {
+    state = value;
+    count++;
+  }
+};
+
+void test_deadband() {
+  Entity entity("sensor.power");
+  StateSubscriber subscriber;
+  entity.add_subscriber(&subscriber);
+  entity.set_state_filter(-1, 5.0f, 0.0f, 0);
+
+  CHECK(entity.set_state("100") == entity_state_result::notified);
+  CHECK(entity.set_state("104.9") == entity_state_result::filtered);
+  CHECK(entity.set_state("95.5") == entity_state_result::filtered);
+  CHECK(entity.set_state("105") == entity_state_result::notified);
+  CHECK(subscriber.count == 2 && subscriber.state == "105");
+  // non-numeric states are never filtered
+  CHECK(entity.set_state("unavailable") == entity_state_result::notified);
+  CHECK(entity.set_state("104") == entity_state_result::notified);
+  CHECK(entity.set_state("106") == entity_state_result::filtered);
+}
+
+void test_precision() {
+  Entity entity("sensor.temperature");
+  entity.set_state_filter(1, 0.0f, 0.0f, 0);
+  CHECK(entity.set_state("21.04") == entity_state_result::notified);
+  CHECK(entity.set_state("20.96") == entity_state_result::filtered);
+  CHECK(entity.set_state("21.06") == entity_state_result::notified);
+}
+
+void test_not_a_number() {
+  Entity entity("sensor.power");
+  StateSubscriber subscriber;
+  entity.add_subscriber(&subscriber);
+  entity.set_state_filter(0, 1.0f, 0.0f, 0);
+
+  // states strtof would accept are changes like any other non-numeric state
+  CHECK(entity.set_state("10") == entity_state_result::notified);
+  for (const char *state : {"nan", "inf", "-inf", "0x10", " 10"}) {
+    CHECK(entity.set_state(state) == entity_state_result::notified);
+    CHECK(subscriber.state == state);
+    // and the filter keeps working afterwards
+    CHECK(entity.set_state("10") == entity_state_result::notified);
+    CHECK(entity.set_state("10.5") == entity_state_result::filtered);
+  }
+}
+
+void test_rate_limit() {
+  Entity entity("sensor.power");
+  StateSubscriber subscriber;
+  entity.add_subscriber(&subscriber);
+  entity.set_state_filter(-1, 0.0f, 0.0f, 1000);
+
+  host_millis = 10000;
+  CHECK(entity.set_state("1") == entity_state_result::notified);
+  host_millis += 100;
+  CHECK(entity.set_state("2") == entity_state_result::rate_limited);
+  CHECK(entity.get_state_filter_delay() == 900);
+  host_millis += 900;
+  CHECK(entity.flush_state());
+  CHECK(!entity.flush_state());
+  CHECK(subscriber.count == 2 && subscriber.state == "2");
+  CHECK(entity.get_state_filter_delay() == 1000);
+}
+
+} // namespace
+
+int main() {
+  test_deadband();
+  test_precision();
+  test_not_a_number();
+  test_rate_limit();
+  return test_result("test_state_filter");
+}
@@ -0,0 +1,121 @@
+// split_str/get_item/count_of/replace_all/find_nth_of/convert_python_arr_str
+// compared against naive reference implementations (see helpers.h)
+#include "helpers.h"
+#include "test.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace esphome::nspanel_lovelace;
+
+namespace {
+
+// split_str skips empty items
+std::vector<std::string> reference_split(char delimiter, const std::string &str) {
+  std::vector<std::string> items;
+  std::string item;
+  for (char c : str) {
+    if (c != delimiter) {
+      item += c;
+      continue;
+    }
+    if (!item.empty()) items.push_back(item);
+    item.clear();
+  }
+  if (!item.empty()) items.push_back(item);
+  return items;
+}
+
+size_t reference_find_nth_of(char delimiter, uint16_t count, const std::string &str) {
+  for (size_t i = 0; i < str.size(); i++) {
+    if (str[i] == delimiter && count != 0 && --count == 0) return i;
+  }
+  return std::string::npos;
+}
+
+// the non-empty quoted values joined by the delimiter, the input if there are none
+std::string reference_convert_python_arr_str(const std::string &str, char delimiter) {
+  std::vector<std::string> values;
+  size_t start;
+  size_t pos = 0;
+  while ((start = str.find('\'', pos)) != std::string::npos) {
+    const size_t stop = str.find('\'', start + 1);
+    if (stop == std::string::npos) break;
+    if (stop > start + 1) values.push_back(str.substr(start + 1, stop - start - 1));
+    pos = stop + 1;
+  }
+  if (values.empty()) return str;
+  std::string result;
+  for (const auto &value : values) result.append(result.empty() ? "" : std::string(1, delimiter)).append(value);
+  return result;
+}
+
+void test_fixed_cases() {
+  std::vector<std::string> items;
+  split_str(',', ",a,,bc,", items);
+  CHECK((items == std::vector<std::string>{"a", "bc"}));
+  items.clear();
+  split_str(',', "a,b,c", items, 2);
+  CHECK((items == std::vector<std::string>{"a", "b"}));
+  items.clear();
+  split_str(',', "a,b", items, 0);
+  CHECK(items.empty());
+
+  std::string item = "unchanged";
+  CHECK(get_item(',', ",a,,bc", 1, item) && item == "bc");
+  CHECK(!get_item(',', "a,bc", 2, item) && item == "bc");
+
+  CHECK(find_nth_of(',', 0, "a,b") == std::string::npos);
+  CHECK(find_nth_of(',', 2, "a,b,c") == 3);
+  CHECK(find_nth_of(',', 3, "a,b,c") == std::string::npos);
+
+  CHECK(convert_python_arr_str("['one', 'two', '']") == "one,two");
+  CHECK(convert_python_arr_str("['one', 'tw") == "one");
+  CHECK(convert_python_arr_str("one,two") == "one,two");
+  CHECK(convert_python_arr_str("['one']", '?') == "one");
+}
+
+void fuzz(unsigned long iterations) {
+  std::mt19937 rng(5);
+  static const char ALPHABET[] = "ab,'x";
+  for (unsigned long n = 0; n < iterations; n++) {
+    std::string str;
+    const int length = rng() % 24;
+    for (int k = 0; k < length; k++) str += ALPHABET[rng() % 5];
+
+    const auto expected = reference_split(',', str);
+    std::vector<std::string> items;
+    split_str(',', str, items);
+    CHECK(items == expected);
+
+    std::string item;
+    for (size_t index = 0; index <= expected.size(); index++) {
+      const bool found = get_item(',', str, index, item);
+      CHECK(found == (index < expected.size()));
+      if (found) CHECK(item == expected[index]);
+    }
+
+    CHECK(count_of(',', str) == static_cast<size_t>(std::count(str.begin(), str.end(), ',')));
+    for (uint16_t count = 0; count < 6; count++) {
+      CHECK(find_nth_of(',', count, str) == reference_find_nth_of(',', count, str));
+    }
+
+    std::string replaced = str;
+    replace_all(replaced, ',', '?');
+    std::string expected_replaced = str;
+    std::replace(expected_replaced.begin(), expected_replaced.end(), ',', '?');
+    CHECK(replaced == expected_replaced);
+
+    CHECK(convert_python_arr_str(str) == reference_convert_python_arr_str(str, ','));
+  }
+}
+
+} // namespace
+
+int main() {
+  test_fixed_cases();
+  fuzz(fuzz_iterations(200000));
+  return test_result("test_string_kernels");
+}